@@ -0,0 +1,771 @@
+// QWinUI 性能基准
+// 控件构造（每个实例的耗时和堆分配）、主题切换及其过渡动画的帧时间、颜色查询、主题文件加载、图标光栅化（冷/热缓存、2000 个图标混合尺寸）、图标查询、图标着色、图标矢量路径绘制、图标缓存多线程压力、软件模糊。
+// 无显示环境下可加 -platform offscreen 运行；--count 指定每类控件的实例数（默认 1000）
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QHash>
+#include <QFileInfo>
+#include <QImage>
+#include <QLinearGradient>
+#include <QMap>
+#include <QPainter>
+#include <QSvgRenderer>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QWidget>
+#include <QWinUI/QWinUIWidget.h>
+#include <QWinUI/QWinUITheme.h>
+#include <QWinUI/QWinUIIconManager.h>
+#include <QWinUI/Controls/QWinUIButton.h>
+#include <QWinUI/Controls/QWinUIIcon.h>
+#include <QWinUI/Controls/QWinUIProgressBar.h>
+#include <QWinUI/Controls/QWinUISlider.h>
+#include <QWinUI/Controls/QWinUITextBox.h>
+#include <QWinUI/Controls/QWinUIToggleSwitch.h>
+#include "QWinUIImageBlur.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+// 统计堆分配：替换全局 operator new。
+// 共享库中的分配在 Linux / macOS 上同样经过这里；Windows 上 DLL 内部的分配不计入
+namespace {
+std::atomic<qint64> g_allocatedBytes{0};
+std::atomic<qint64> g_allocationCount{0};
+}
+
+void* operator new(std::size_t size)
+{
+    g_allocatedBytes.fetch_add(qint64(size), std::memory_order_relaxed);
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+
+double toMs(qint64 ns)
+{
+    return ns / 1e6;
+}
+
+// 构造 count 个控件，再显示一次（包含首次样式计算和绘制）
+template <typename Control>
+void benchmarkConstruction(const char* name, int count)
+{
+    QWidget host;
+    host.resize(800, 600);
+
+    const qint64 bytesBefore = g_allocatedBytes.load();
+    const qint64 allocationsBefore = g_allocationCount.load();
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < count; ++i) {
+        new Control(&host);
+    }
+    const qint64 constructNs = timer.nsecsElapsed();
+    const qint64 bytes = g_allocatedBytes.load() - bytesBefore;
+    const qint64 allocations = g_allocationCount.load() - allocationsBefore;
+
+    timer.restart();
+    host.show();
+    QApplication::processEvents();
+    const qint64 showNs = timer.nsecsElapsed();
+
+    std::printf("  %-20s %10.2f us/个 %10lld 字节/个 %8.1f 次分配/个   显示 %8.2f ms\n",
+                name, constructNs / 1e3 / count, bytes / count, double(allocations) / count, toMs(showNs));
+}
+
+void benchmarkThemeSwitch(int count, int rounds)
+{
+    QWidget host;
+    host.resize(800, 600);
+    for (int i = 0; i < count; ++i) {
+        new QWinUIButton(QStringLiteral("Button"), &host);
+        new QWinUIToggleSwitch(&host);
+        new QWinUITextBox(&host);
+        new QWinUISlider(&host);
+    }
+    host.show();
+    QApplication::processEvents();
+
+    QWinUITheme* theme = QWinUITheme::getInstance();
+    const QWinUIThemeMode original = theme->themeMode();
+
+    qint64 bestNs = std::numeric_limits<qint64>::max();
+    qint64 totalNs = 0;
+    QElapsedTimer timer;
+    for (int i = 0; i < rounds; ++i) {
+        const QWinUIThemeMode mode = theme->isDarkMode() ? QWinUIThemeMode::Light : QWinUIThemeMode::Dark;
+        timer.start();
+        theme->setThemeMode(mode);
+        QApplication::processEvents(); // 包含随后的重绘
+        const qint64 ns = timer.nsecsElapsed();
+        bestNs = qMin(bestNs, ns);
+        totalNs += ns;
+    }
+    theme->setThemeMode(original);
+    QApplication::processEvents();
+
+    std::printf("  %d 个控件：平均 %.2f ms，最快 %.2f ms（%d 次切换）\n",
+                count * 4, toMs(totalNs / rounds), toMs(bestNs), rounds);
+}
+
+// 记录覆盖层每次绘制的时刻，相邻两次之差即为帧时间
+class FrameRecorder : public QObject
+{
+public:
+    QList<qint64> frameTimes; // 纳秒，相对于 timer 的起点
+    QElapsedTimer timer;
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override
+    {
+        if (event->type() == QEvent::Paint) {
+            frameTimes.append(timer.nsecsElapsed());
+        }
+        return QObject::eventFilter(watched, event);
+    }
+};
+
+// 带覆盖层的主题切换动画：顶层 QWinUIWidget 窗口中 controls 个控件，分三层嵌套在容器中
+void benchmarkThemeTransition(int controls)
+{
+    QWinUIWidget window;
+    window.resize(1280, 800);
+
+    const int perLeaf = 10;
+    const int perGroup = 10;
+    int created = 0;
+    for (int g = 0; created < controls; ++g) {
+        QWidget* group = new QWidget(&window);
+        group->setGeometry((g % 4) * 320, (g / 4) * 160 % 800, 320, 160);
+        for (int l = 0; l < perGroup && created < controls; ++l) {
+            QWidget* leaf = new QWidget(group);
+            leaf->setGeometry((l % 2) * 160, (l / 2) * 32, 160, 32);
+            for (int i = 0; i < perLeaf && created < controls; ++i, ++created) {
+                QWidget* control = (i % 2) ? static_cast<QWidget*>(new QWinUIToggleSwitch(leaf))
+                                           : static_cast<QWidget*>(new QWinUIButton(QStringLiteral("B"), leaf));
+                control->setGeometry((i % 5) * 32, (i / 5) * 16, 32, 16);
+            }
+        }
+    }
+    window.show();
+    QApplication::processEvents();
+
+    QWinUITheme* theme = QWinUITheme::getInstance();
+    const bool transitionEnabled = theme->isThemeTransitionEnabled();
+    const int transitionMode = theme->themeTransitionMode();
+    theme->setThemeTransitionEnabled(true);
+
+    const int modes[] = { QWinUIWidget::RippleTransition, QWinUIWidget::FadeTransition };
+    for (int mode : modes) {
+        theme->setThemeTransitionMode(mode);
+
+        FrameRecorder recorder;
+        recorder.timer.start();
+        theme->setThemeMode(theme->isDarkMode() ? QWinUIThemeMode::Light : QWinUIThemeMode::Dark);
+        const qint64 startNs = recorder.timer.nsecsElapsed(); // 旧主题快照 + 切换调色板
+
+        // 覆盖层是内部类，按类名查找；动画结束时覆盖层自行销毁
+        QWidget* overlay = nullptr;
+        for (QWidget* child : window.findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly)) {
+            if (child->inherits("QWinUIThemeTransitionOverlay")) {
+                overlay = child;
+            }
+        }
+        if (!overlay) {
+            std::printf("  未启动过渡动画，跳过\n");
+            break;
+        }
+        overlay->installEventFilter(&recorder);
+        QEventLoop loop;
+        QObject::connect(overlay, &QObject::destroyed, &loop, &QEventLoop::quit);
+        loop.exec();
+
+        QList<qint64> intervals;
+        for (int i = 1; i < recorder.frameTimes.size(); ++i) {
+            intervals.append(recorder.frameTimes.at(i) - recorder.frameTimes.at(i - 1));
+        }
+        std::sort(intervals.begin(), intervals.end());
+        const qint64 median = intervals.isEmpty() ? 0 : intervals.at(intervals.size() / 2);
+        const qint64 worst = intervals.isEmpty() ? 0 : intervals.last();
+        const qint64 firstFrame = recorder.frameTimes.isEmpty() ? 0 : recorder.frameTimes.first() - startNs;
+
+        std::printf("  %-6s %d 个控件：开始 %.2f ms，首帧 %.2f ms，帧时间中位数 %.2f ms，最慢 %.2f ms（%lld 帧）\n",
+                    mode == QWinUIWidget::RippleTransition ? "涟漪" : "淡入", created, toMs(startNs),
+                    toMs(firstFrame), toMs(median), toMs(worst), qint64(recorder.frameTimes.size()));
+    }
+
+    theme->setThemeTransitionMode(transitionMode);
+    theme->setThemeTransitionEnabled(transitionEnabled);
+}
+
+// 颜色查询：令牌下标与字符串名称两条路径，另附旧实现使用的 QMap<QString, QColor> 作为对照
+void benchmarkColorLookup(int lookups)
+{
+    QWinUITheme* theme = QWinUITheme::getInstance();
+    const int tokenCount = QWinUITheme::ColorTokenCount;
+    QList<QString> names;
+    QMap<QString, QColor> legacyMap;
+    for (int i = 0; i < tokenCount; ++i) {
+        const auto token = static_cast<QWinUITheme::ColorToken>(i);
+        names.append(QWinUITheme::colorTokenName(token));
+        legacyMap.insert(names.last(), theme->getColor(token));
+    }
+
+    // 累加结果，避免查询被优化掉
+    volatile int sink = 0;
+    QElapsedTimer timer;
+
+    timer.start();
+    int sum = 0;
+    for (int i = 0; i < lookups; ++i) {
+        sum += theme->getColor(static_cast<QWinUITheme::ColorToken>(i % tokenCount)).alpha();
+    }
+    const qint64 tokenNs = timer.nsecsElapsed();
+    sink = sink + sum;
+
+    timer.restart();
+    sum = 0;
+    for (int i = 0; i < lookups; ++i) {
+        sum += theme->getColor(names.at(i % tokenCount)).alpha();
+    }
+    const qint64 nameNs = timer.nsecsElapsed();
+    sink = sink + sum;
+
+    timer.restart();
+    sum = 0;
+    for (int i = 0; i < lookups; ++i) {
+        sum += legacyMap.value(names.at(i % tokenCount)).alpha();
+    }
+    const qint64 mapNs = timer.nsecsElapsed();
+    sink = sink + sum;
+
+    std::printf("  令牌 %.2f ns/次   名称 %.2f ns/次   QMap 对照 %.2f ns/次（%d 次查询）\n",
+                double(tokenNs) / lookups, double(nameNs) / lookups, double(mapNs) / lookups, lookups);
+}
+
+// 主题文件加载：令牌颜色全部覆盖，其余用自定义颜色补足到 tokens 个
+void benchmarkThemeLoad(int tokens)
+{
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        std::printf("  无法创建临时目录，跳过\n");
+        return;
+    }
+    const QString path = dir.filePath(QStringLiteral("theme.qwth"));
+
+    QWinUITheme* theme = QWinUITheme::getInstance();
+    theme->beginUpdate();
+    for (int i = 0; i < tokens; ++i) {
+        const QColor color = QColor::fromHsv(i * 7 % 360, 128 + i % 128, 200);
+        if (i < QWinUITheme::ColorTokenCount) {
+            theme->setColor(static_cast<QWinUITheme::ColorToken>(i), color);
+        } else {
+            theme->setColor(QStringLiteral("Brand.Color%1").arg(i), color);
+        }
+    }
+    theme->endUpdate();
+    if (!theme->saveTheme(path)) {
+        std::printf("  保存主题文件失败，跳过\n");
+        return;
+    }
+
+    // 首次加载：进程内第一次解析该文件
+    QElapsedTimer timer;
+    timer.start();
+    const bool loaded = theme->loadTheme(path);
+    const qint64 coldNs = timer.nsecsElapsed();
+    if (!loaded) {
+        std::printf("  加载主题文件失败，跳过\n");
+        return;
+    }
+
+    const int rounds = 20;
+    qint64 bestNs = std::numeric_limits<qint64>::max();
+    for (int i = 0; i < rounds; ++i) {
+        timer.restart();
+        theme->loadTheme(path);
+        bestNs = qMin(bestNs, timer.nsecsElapsed());
+    }
+
+    std::printf("  %d 个颜色（%lld 字节）：首次 %.3f ms，重复加载最快 %.3f ms\n",
+                tokens, QFileInfo(path).size(), toMs(coldNs), toMs(bestNs));
+}
+
+void benchmarkIconRaster(int count)
+{
+    QWinUIIconManager* manager = QWinUIIconManager::getInstance();
+    QStringList names = manager->getIconNames();
+    if (names.isEmpty()) {
+        std::printf("  没有可用的图标（未找到图标包），跳过\n");
+        return;
+    }
+    names = names.mid(0, count);
+
+    const QSize sizes[] = { QSize(16, 16), QSize(32, 32), QSize(64, 64) };
+    const qreal ratios[] = { 1.0, 2.0 };
+    for (const QSize& size : sizes) {
+        for (qreal dpr : ratios) {
+            // 冷缓存包含SVG解析，热缓存只有查找
+            manager->clearCache();
+            QElapsedTimer timer;
+            timer.start();
+            for (const QString& name : std::as_const(names)) {
+                manager->getIconImage(name, size, Qt::black, dpr);
+            }
+            const qint64 coldNs = timer.nsecsElapsed();
+
+            timer.restart();
+            for (const QString& name : std::as_const(names)) {
+                manager->getIconImage(name, size, Qt::black, dpr);
+            }
+            const qint64 warmNs = timer.nsecsElapsed();
+
+            std::printf("  %3dx%-3d @%.0fx  冷 %8.2f us/个   热 %8.3f us/个（%lld 个图标）\n",
+                        size.width(), size.height(), dpr, coldNs / 1e3 / names.size(),
+                        warmNs / 1e3 / names.size(), qint64(names.size()));
+        }
+    }
+}
+
+// 2000 个不同图标按混合尺寸渲染：每个图标三种尺寸，SVG 只应解析一次，
+// 第二遍应全部命中光栅缓存；输出文档层和光栅层的命中、未命中次数
+void benchmarkIconMixedSizes(int count)
+{
+    QWinUIIconManager* manager = QWinUIIconManager::getInstance();
+    const QStringList names = manager->getIconNames().mid(0, count);
+    if (names.isEmpty()) {
+        std::printf("  没有可用的图标（未找到图标包），跳过\n");
+        return;
+    }
+
+    const QSize sizes[] = { QSize(16, 16), QSize(24, 24), QSize(32, 32) };
+    const int requests = int(names.size()) * 3;
+    manager->setCacheLimit(requests);
+    manager->setDocumentCacheLimit(int(names.size()));
+
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass == 0) {
+            manager->clearCache();
+        }
+        manager->resetCacheStats();
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < names.size(); ++i) {
+            // 尺寸顺序按图标轮换，相邻请求不是同一尺寸
+            for (int s = 0; s < 3; ++s) {
+                manager->getIconImage(names.at(i), sizes[(i + s) % 3], Qt::black);
+            }
+        }
+        const qint64 ns = timer.nsecsElapsed();
+
+        const QWinUIIconCacheStats stats = manager->getCacheStats();
+        std::printf("  %s %8.2f ms（%6.2f us/次）  文档 命中 %llu 未命中 %llu   光栅 命中 %llu 未命中 %llu 淘汰 %llu\n",
+                    pass == 0 ? "冷" : "热", toMs(ns), ns / 1e3 / requests,
+                    static_cast<unsigned long long>(stats.documentHits),
+                    static_cast<unsigned long long>(stats.documentMisses),
+                    static_cast<unsigned long long>(stats.rasterHits),
+                    static_cast<unsigned long long>(stats.rasterMisses),
+                    static_cast<unsigned long long>(stats.rasterEvictions));
+    }
+    std::printf("  %lld 个图标 × 3 种尺寸，缓存 %d 张光栅图、%lld 字节\n",
+                qint64(names.size()), manager->getCacheSize(), manager->getCacheBytes());
+
+    manager->clearCache();
+    manager->setCacheLimit(1024);
+    manager->setDocumentCacheLimit(64);
+}
+
+// 多线程压力：threads 个线程同时查询共享缓存，约 90% 命中预热的热点图标，
+// 其余请求随机尺寸的冷图标（线程之间会撞上同一个键，测试去重）。
+// 竞争用两项指标衡量：相对单线程的扩展效率，以及命中请求的 p99 延迟
+void benchmarkIconConcurrency(int opsPerThread)
+{
+    QWinUIIconManager* manager = QWinUIIconManager::getInstance();
+    const QStringList names = manager->getIconNames();
+    if (names.size() < 64) {
+        std::printf("  没有足够的图标（未找到图标包），跳过\n");
+        return;
+    }
+    const QStringList hot = names.mid(0, 64);
+
+    // 冷请求不应把热点挤出缓存
+    const qint64 byteLimit = manager->getCacheByteLimit();
+    manager->setCacheLimit(1 << 20);
+    manager->setCacheByteLimit(qint64(1) << 30);
+
+    double singleThreadRate = 0.0;
+    const int maxThreads = qMax(2, QThread::idealThreadCount());
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        manager->clearCache();
+        for (const QString& name : hot) {
+            manager->getIconImage(name, QSize(16, 16), Qt::black);
+        }
+        manager->resetCacheStats();
+
+        QList<QList<qint64>> hitLatencies(threads);
+        QList<QThread*> workers;
+        for (int t = 0; t < threads; ++t) {
+            QList<qint64>* latencies = &hitLatencies[t];
+            workers.append(QThread::create([manager, &names, &hot, latencies, opsPerThread, t]() {
+                quint32 state = 0x9E3779B9u ^ quint32(t * 7919 + 1);
+                auto next = [&state]() {
+                    state ^= state << 13;
+                    state ^= state >> 17;
+                    state ^= state << 5;
+                    return state;
+                };
+                latencies->reserve(opsPerThread);
+                QElapsedTimer timer;
+                for (int i = 0; i < opsPerThread; ++i) {
+                    const quint32 r = next();
+                    if (r % 10 != 0) {
+                        timer.start();
+                        manager->getIconImage(hot.at(int(r / 10 % quint32(hot.size()))), QSize(16, 16), Qt::black);
+                        latencies->append(timer.nsecsElapsed());
+                    } else {
+                        const int size = 17 + int(next() % 48);
+                        manager->getIconImage(names.at(int(next() % quint32(names.size()))), QSize(size, size), Qt::black);
+                    }
+                }
+            }));
+        }
+
+        QElapsedTimer wall;
+        wall.start();
+        for (QThread* worker : std::as_const(workers)) {
+            worker->start();
+        }
+        for (QThread* worker : std::as_const(workers)) {
+            worker->wait();
+            delete worker;
+        }
+        const qint64 wallNs = wall.nsecsElapsed();
+
+        QList<qint64> latencies;
+        for (const QList<qint64>& perThread : std::as_const(hitLatencies)) {
+            latencies += perThread;
+        }
+        std::sort(latencies.begin(), latencies.end());
+        const qint64 p50 = latencies.isEmpty() ? 0 : latencies.at(latencies.size() / 2);
+        const qint64 p99 = latencies.isEmpty() ? 0 : latencies.at(latencies.size() * 99 / 100);
+
+        const QWinUIIconCacheStats stats = manager->getCacheStats();
+        const double rate = double(opsPerThread) * threads / (wallNs / 1e9);
+        if (threads == 1) {
+            singleThreadRate = rate;
+        }
+        std::printf("  %2d 线程 %10.0f 次/秒  扩展效率 %5.1f%%  命中延迟 p50 %6.2f us p99 %7.2f us"
+                    "  命中 %llu 未命中 %llu 等待 %llu\n",
+                    threads, rate, 100.0 * rate / (singleThreadRate * threads), p50 / 1e3, p99 / 1e3,
+                    static_cast<unsigned long long>(stats.rasterHits),
+                    static_cast<unsigned long long>(stats.rasterMisses),
+                    static_cast<unsigned long long>(stats.rasterWaits));
+    }
+
+    manager->clearCache();
+    manager->setCacheLimit(1024);
+    manager->setCacheByteLimit(byteLimit);
+}
+
+// 图标查询：索引构建一次，之后的前缀、子串、标签和分类查询
+void benchmarkIconQuery()
+{
+    QWinUIIconManager* manager = QWinUIIconManager::getInstance();
+    const QString packPath = QWinUIIconManager::defaultIconPackPath();
+    if (!manager->loadIconPack(packPath)) {
+        std::printf("  没有可用的图标（未找到图标包），跳过\n");
+        return;
+    }
+
+    // 重新加载图标包使索引失效，第一次查询包含索引构建
+    QElapsedTimer timer;
+    timer.start();
+    const QStringList names = manager->getIconNames();
+    const qint64 buildNs = timer.nsecsElapsed();
+
+    // 查询词取自图标名称：基础名称的前缀、中间的片段和以 '-' 分隔的单词
+    QStringList prefixes;
+    QStringList fragments;
+    QStringList tags;
+    for (int i = 0; i < names.size(); i += qMax(1, int(names.size() / 200))) {
+        const QString baseName = names.at(i).section(QLatin1Char('/'), -1);
+        prefixes << baseName.left(1) << baseName.left(3);
+        if (baseName.size() > 4) {
+            fragments << baseName.mid(1, 3);
+        }
+        tags << baseName.section(QLatin1Char('-'), 0, 0);
+    }
+
+    auto run = [](const char* label, const QStringList& terms, const auto& query) {
+        if (terms.isEmpty()) {
+            return;
+        }
+        qint64 results = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (const QString& term : terms) {
+            results += query(term).size();
+        }
+        const qint64 ns = timer.nsecsElapsed();
+        std::printf("  %-8s %8.2f us/次   平均 %.1f 个结果（%lld 次查询）\n",
+                    label, ns / 1e3 / terms.size(), double(results) / terms.size(), qint64(terms.size()));
+    };
+
+    std::printf("  索引构建 %.2f ms（%lld 个图标，%lld 个分类）\n",
+                toMs(buildNs), qint64(names.size()), qint64(manager->getCategories().size()));
+    run("前缀", prefixes, [manager](const QString& term) { return manager->findIconsByPrefix(term, 50); });
+    run("前缀全部", prefixes, [manager](const QString& term) { return manager->findIconsByPrefix(term); });
+    run("子串", fragments, [manager](const QString& term) { return manager->findIconsContaining(term, 50); });
+    run("标签", tags, [manager](const QString& term) { return manager->getIconsByTag(term); });
+    run("分类", manager->getCategories(), [manager](const QString& term) { return manager->getIconsByCategory(term); });
+}
+
+// 矢量路径绘制与 QSvgRenderer::render 对比：带旋转变换，模拟旋转和缩放动画中的逐帧绘制
+void benchmarkIconVector(int count)
+{
+    QWinUIIconManager* manager = QWinUIIconManager::getInstance();
+    const QStringList names = manager->getIconNames().mid(0, count);
+    if (names.isEmpty()) {
+        std::printf("  没有可用的图标（未找到图标包），跳过\n");
+        return;
+    }
+
+    // 路径和SVG文档都预先准备好，只比较绘制本身
+    QList<QWinUIIconVector> vectors;
+    QList<QSvgRenderer*> renderers;
+    for (const QString& name : names) {
+        vectors.append(manager->getIconVector(name));
+        renderers.append(new QSvgRenderer(manager->getIconData(manager->getIconInfo(name).filePath)));
+    }
+
+    const int sizes[] = { 16, 32, 64, 128, 256 };
+    QImage target(300, 300, QImage::Format_ARGB32_Premultiplied);
+    for (int size : sizes) {
+        const QRectF rect(-size / 2.0, -size / 2.0, size, size);
+        qint64 vectorNs = 0;
+        qint64 svgNs = 0;
+        QElapsedTimer timer;
+        for (int pass = 0; pass < 2; ++pass) {
+            target.fill(Qt::white);
+            QPainter painter(&target);
+            painter.setRenderHint(QPainter::Antialiasing);
+            painter.translate(150, 150);
+            timer.start();
+            for (int i = 0; i < names.size(); ++i) {
+                painter.save();
+                painter.rotate(i * 7.5);
+                if (pass == 0) {
+                    QWinUIIconManager::drawIconVector(&painter, vectors.at(i), rect, Qt::black);
+                } else {
+                    renderers.at(i)->render(&painter, rect);
+                }
+                painter.restore();
+            }
+            (pass == 0 ? vectorNs : svgNs) = timer.nsecsElapsed();
+        }
+        std::printf("  %3dpx  矢量路径 %8.2f us/次   QSvgRenderer %8.2f us/次   %.1fx\n",
+                    size, vectorNs / 1e3 / names.size(), svgNs / 1e3 / names.size(),
+                    vectorNs > 0 ? double(svgNs) / vectorNs : 0.0);
+    }
+    qDeleteAll(renderers);
+}
+
+// 旧实现的着色方式：每种颜色复制一份完整的 ARGB 图像
+QImage colorizeLegacy(const QImage& image, const QColor& color)
+{
+    QImage result = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&result);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+    painter.fillRect(result.rect(), color);
+    return result;
+}
+
+// 着色图标：每个图标缓存一份 Alpha8 遮罩、绘制时着色，对比旧实现按颜色各缓存一份 ARGB 光栅图
+void benchmarkIconTint(int count)
+{
+    QWinUIIconManager* manager = QWinUIIconManager::getInstance();
+    const QStringList names = manager->getIconNames().mid(0, count);
+    if (names.isEmpty()) {
+        std::printf("  没有可用的图标（未找到图标包），跳过\n");
+        return;
+    }
+
+    // 常态、悬停、按下、禁用四种颜色
+    const QColor colors[] = { QColor(0, 0, 0, 228), QColor(0, 0, 0, 158), QColor(0, 120, 215), QColor(0, 0, 0, 92) };
+    const QSize size(24, 24);
+    QImage target(256, 256, QImage::Format_ARGB32_Premultiplied);
+    target.fill(Qt::white);
+    QElapsedTimer timer;
+
+    // 遮罩路径：缓存中只有遮罩，每次绘制时着色
+    manager->clearCache();
+    for (const QString& name : names) {
+        for (const QColor& color : colors) {
+            manager->getIconImage(name, size, color);
+        }
+    }
+    const qint64 maskBytes = manager->getCacheBytes();
+    timer.start();
+    {
+        QPainter painter(&target);
+        for (const QString& name : names) {
+            for (const QColor& color : colors) {
+                painter.drawImage(0, 0, manager->getIconImage(name, size, color));
+            }
+        }
+    }
+    const qint64 maskNs = timer.nsecsElapsed();
+
+    // 旧路径：每种颜色一份 ARGB 图像，绘制时直接取用
+    QHash<QString, QImage> legacyCache;
+    qint64 legacyBytes = 0;
+    for (const QString& name : names) {
+        const QImage image = manager->getIconImage(name, size);
+        for (const QColor& color : colors) {
+            const QImage colored = colorizeLegacy(image, color);
+            legacyBytes += colored.sizeInBytes();
+            legacyCache.insert(name + QLatin1Char('|') + color.name(QColor::HexArgb), colored);
+        }
+    }
+    timer.restart();
+    {
+        QPainter painter(&target);
+        for (const QString& name : names) {
+            for (const QColor& color : colors) {
+                painter.drawImage(0, 0, legacyCache.value(name + QLatin1Char('|') + color.name(QColor::HexArgb)));
+            }
+        }
+    }
+    const qint64 legacyNs = timer.nsecsElapsed();
+
+    const qint64 draws = qint64(names.size()) * 4;
+    std::printf("  遮罩   缓存 %8lld 字节   绘制 %7.3f us/次\n", maskBytes, maskNs / 1e3 / draws);
+    std::printf("  ARGB   缓存 %8lld 字节   绘制 %7.3f us/次（%lld 个图标 × 4 种颜色，%dx%d）\n",
+                legacyBytes, legacyNs / 1e3 / draws, qint64(names.size()), size.width(), size.height());
+}
+
+// 带有色块和渐变的测试图，避免纯色图像走特殊路径
+QImage blurSource(const QSize& size)
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+    QLinearGradient gradient(0, 0, size.width(), size.height());
+    gradient.setColorAt(0.0, QColor(0, 120, 215));
+    gradient.setColorAt(1.0, QColor(243, 243, 243));
+    painter.fillRect(image.rect(), gradient);
+    for (int y = 0; y < size.height(); y += 64) {
+        for (int x = (y / 64) % 2 * 64; x < size.width(); x += 128) {
+            painter.fillRect(x, y, 64, 64, QColor(32, 32, 32, 160));
+        }
+    }
+    return image;
+}
+
+void benchmarkBlur()
+{
+    const QSize sizes[] = { QSize(256, 256), QSize(1920, 1080), QSize(3840, 2160) };
+    const qreal radii[] = { 4, 8, 16, 32, 64 };
+    for (const QSize& size : sizes) {
+        const QImage source = blurSource(size);
+        // 大图少跑几次，每组总耗时大致相当
+        const int iterations = qBound(3, int(4096LL * 4096 / (qint64(size.width()) * size.height())), 50);
+        for (qreal radius : radii) {
+            QWinUIImageBlur::blur(source, radius); // 预热线程池
+            qint64 bestNs = std::numeric_limits<qint64>::max();
+            QElapsedTimer timer;
+            for (int i = 0; i < iterations; ++i) {
+                timer.start();
+                const QImage result = QWinUIImageBlur::blur(source, radius);
+                bestNs = qMin(bestNs, timer.nsecsElapsed());
+                Q_UNUSED(result);
+            }
+            std::printf("  %4dx%-4d 半径 %3.0f  %8.2f ms（最快，%d 次）\n",
+                        size.width(), size.height(), radius, toMs(bestNs), iterations);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+    app.setApplicationName("QWinUI Benchmark");
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption countOption(QStringList() << "c" << "count",
+                                   "Instances per control class (default 1000).", "count", "1000");
+    parser.addOption(countOption);
+    parser.process(app);
+    const int count = qMax(1, parser.value(countOption).toInt());
+
+    QWinUITheme::getInstance()->setThemeMode(QWinUIThemeMode::Light);
+
+    std::printf("控件构造（每类 %d 个）\n", count);
+    benchmarkConstruction<QWinUIButton>("QWinUIButton", count);
+    benchmarkConstruction<QWinUIToggleSwitch>("QWinUIToggleSwitch", count);
+    benchmarkConstruction<QWinUITextBox>("QWinUITextBox", count);
+    benchmarkConstruction<QWinUISlider>("QWinUISlider", count);
+    benchmarkConstruction<QWinUIProgressBar>("QWinUIProgressBar", count);
+    benchmarkConstruction<QWinUIIcon>("QWinUIIcon", count);
+
+    std::printf("\n主题切换\n");
+    benchmarkThemeSwitch(qMax(1, count / 4), 10);
+
+    std::printf("\n主题切换动画（嵌套控件）\n");
+    benchmarkThemeTransition(2000);
+
+    std::printf("\n颜色查询\n");
+    benchmarkColorLookup(1000000);
+
+    std::printf("\n主题文件加载\n");
+    benchmarkThemeLoad(500);
+    QWinUITheme::getInstance()->resetToDefault();
+    QWinUITheme::getInstance()->setThemeMode(QWinUIThemeMode::Light);
+
+    std::printf("\n图标光栅化\n");
+    benchmarkIconRaster(qMin(count, 500));
+
+    std::printf("\n图标混合尺寸渲染\n");
+    benchmarkIconMixedSizes(2000);
+
+    std::printf("\n图标查询\n");
+    benchmarkIconQuery();
+
+    std::printf("\n图标着色（遮罩与按颜色缓存对比）\n");
+    benchmarkIconTint(qMin(count, 500));
+
+    std::printf("\n图标矢量路径绘制（%d 个图标）\n", qMin(count, 200));
+    benchmarkIconVector(qMin(count, 200));
+
+    std::printf("\n图标缓存多线程压力\n");
+    benchmarkIconConcurrency(20000);
+
+    std::printf("\n软件模糊\n");
+    benchmarkBlur();
+
+    return 0;
+}
@@ -7,6 +7,9 @@
 
 QT_BEGIN_NAMESPACE
 
+class QWinUIAcrylicBackdropTracker;
+class QWinUIAcrylicEffectCache;
+
 // 背景源类型枚举
 enum class QWinUIAcrylicBackgroundSource {
     HostBackdrop,  // 使用主机背景（窗口后面的内容）
@@ -65,6 +68,11 @@ public:
     void animateTintOpacity(double targetOpacity, int duration = 300);
     void animateTintColor(const QColor& targetColor, int duration = 300);
 
+    // 进程内共享的效果缓存（模糊后的背景，不含着色层）：尺寸、模糊半径和背景内容
+    // 都相同的画刷共用同一份结果；maxBytes 为缓存的内存上限
+    static void setEffectCacheByteLimit(qint64 maxBytes);
+    static qint64 effectCacheByteLimit();
+
     // 尺寸建议
     QSize sizeHint() const override;
     QSize minimumSizeHint() const override;
@@ -81,7 +89,9 @@ signals:
 
 protected:
     // 事件处理
+    void paintEvent(QPaintEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
+    void moveEvent(QMoveEvent* event) override;
     void showEvent(QShowEvent* event) override;
     void hideEvent(QHideEvent* event) override;
 
@@ -95,12 +105,23 @@ private slots:
 
 private:
     void initializeComponent();
-    void updateEffectState();
     void updateThemeColors();
-    void captureBackground();
-    void generateNoiseTexture();
-    QPixmap applyAcrylicEffect(const QPixmap& background);
+    // Backdrop 背景源：离屏绘制画刷下方的祖先和兄弟控件（不含画刷自身及其子控件），
+    // 只重新抓取和模糊发生变化的区域
+    bool usesBackdropCapture() const;
+    bool isBackdropWidget(const QWidget* widget) const; // 控件是否位于画刷下方
+    void markBackdropDirty(const QRegion& region);
+    void markSelfPainted(const QRegion& region); // 画刷或其子控件自身的重绘区域（画刷坐标）
+    void scheduleBackdropRefresh();
+    void deferBackdropRefresh(); // 尺寸或位置变化：连续变化停止后再整体刷新
+    QRegion captureBackground(const QRegion& region); // 返回内容有变化的区域
+    void renderBackdrop(QPainter* painter, const QRect& rect);
+    QRect updateEffect(const QRect& rect); // 重新模糊 rect 影响到的区域，返回需要重绘的区域
+    QImage sharedBlurredBackdrop(const QImage& background); // 先查共享缓存，未命中时模糊并放入缓存
+    QImage blurBackdrop(const QImage& background);
+    void paintTintLayers(QPainter* painter); // 亮度层和着色层在绘制时叠加，不写入缓存
     QColor calculateLuminosityColor() const;
+    void applyTintChange(); // 着色参数变化
     bool shouldUseFallback() const;
     void setupAnimations();
     void applyAcrylicStyle();
@@ -117,26 +138,34 @@ private:
     double m_blurRadius;
     double m_noiseOpacity;
 
-    // 效果相关
-    QPixmap m_backgroundCapture;
-    QPixmap m_noiseTexture;
-    QPixmap m_cachedEffect;
-    bool m_needsBackgroundUpdate;
+    // 效果相关（按设备像素存储）
+    QImage m_backgroundCapture; // 未处理的背景
+    QImage m_cachedEffect;      // 模糊后的背景（不含着色层）
+    QRegion m_dirtyBackdrop;    // 待重新抓取的区域（逻辑坐标）
+    QRegion m_selfPainted;      // 同一轮绘制中画刷自身重绘的区域，从待抓取区域中扣除
+    bool m_needsBackgroundUpdate; // 需要整体重新抓取
+    bool m_backdropRefreshPending;
     bool m_isCapturing;
 
     // 动画
     QPropertyAnimation* m_tintOpacityAnimation;
     QPropertyAnimation* m_tintColorAnimation;
 
-    // 更新定时器
-    QTimer* m_updateTimer;
+    // 尺寸、位置连续变化（拖动调整）期间推迟重新抓取，停止变化后触发
+    QTimer* m_geometryTimer;
 
     // 常量
     static constexpr double DEFAULT_TINT_OPACITY = 0.8;
     static constexpr double DEFAULT_LUMINOSITY_OPACITY = 0.85;
     static constexpr double DEFAULT_BLUR_RADIUS = 30.0;
     static constexpr double DEFAULT_NOISE_OPACITY = 0.02;
-    static constexpr int UPDATE_INTERVAL_MS = 16; // ~60 FPS
+    static constexpr int GEOMETRY_SETTLE_MS = 120;
+    static constexpr double CORNER_RADIUS = 8.0;
+    static constexpr int MAX_DIRTY_RECTS = 8; // 脏矩形过多时合并为外接矩形
+    static constexpr qint64 DEFAULT_EFFECT_CACHE_BYTES = 32 * 1024 * 1024;
+
+    friend class QWinUIAcrylicBackdropTracker;
+    friend class QWinUIAcrylicEffectCache;
 };
 
 QT_END_NAMESPACE
@@ -38,7 +38,7 @@ protected:
     void showEvent(QShowEvent* event) override;
 
 private slots:
-    void onThemeChanged();
+    void onThemeChanged() override;
 
 private:
     void initializeSeparator();
@@ -75,6 +75,9 @@ protected:
     void focusInEvent(QFocusEvent* event) override;
     void focusOutEvent(QFocusEvent* event) override;
 
+    // 主题处理
+    QWinUITheme::ColorTokenSet themeColorTokens() const override;
+
     // 为子类提供的状态设置方法
     void setCheckedState(bool checked);
     bool isCheckedState() const;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "QWinUI/QWinUIWidget.h"
+#include "QWinUI/QWinUIIconManager.h"
 #include <QSvgRenderer>
 #include <QPropertyAnimation>
 
@@ -93,10 +94,12 @@ protected:
 
     // 主题处理
     void onThemeChanged() override;
+    QWinUITheme::ColorTokenSet themeColorTokens() const override;
 
 private slots:
     void onRotationAnimationFinished();
     void onOpacityAnimationFinished();
+    void onIconReady(const QString& filePath, const QSize& size, qreal devicePixelRatio, const QImage& image);
 
 private:
     void initializeComponent();
@@ -104,9 +107,12 @@ private:
     void updateThemeColor();
     QColor getEffectiveIconColor() const;
     QTransform getTransform() const;
+    bool isTransformed() const; // 旋转角度非零或旋转动画运行中
     QString getResourcePath(const QString& iconName) const;
     QChar getFluentIconChar(const QString& iconName) const;
     QPixmap renderFontIcon() const;
+    // async 为 true 时未命中缓存的资源图标在后台光栅化，先返回占位图，ready 置为 false
+    QPixmap loadPixmap(bool async, bool* ready) const;
 
     // 成员变量
     QString m_iconName;
@@ -128,9 +134,11 @@ private:
     QChar m_fontIconChar;
     bool m_isFontIcon;
 
-    // 缓存
+    // 缓存（与旋转角度无关，旋转在绘制时通过变换完成）
     QPixmap m_cachedPixmap;
-    QString m_lastCacheKey;
+    QColor m_cachedColor;
+    qreal m_cachedDevicePixelRatio; // 移动到不同缩放的屏幕时重新光栅化
+    QWinUIIconVector m_cachedVector; // 旋转时使用的矢量路径
 
     // 动画
     QPropertyAnimation* m_rotationAnimation;
@@ -82,11 +82,11 @@ signals:
 protected:
     void paintEvent(QPaintEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
+    void showEvent(QShowEvent* event) override;
 
 private slots:
     void onAnimationValueChanged(const QVariant& value);
-    void onIndeterminateAnimation();
-    void onThemeChanged();
+    void onThemeChanged() override;
 
 private:
     void initializeProgressBar();
@@ -94,6 +94,8 @@ private:
     void startValueAnimation(double targetValue);
     void startIndeterminateAnimation();
     void stopIndeterminateAnimation();
+    void resumeIndeterminateAnimation();
+    void onIndeterminateAnimation(qint64 deltaMs);
     void updateAnimatedValue();
     
     // 绘制方法
@@ -128,9 +130,9 @@ private:
     
     // 动画相关
     QPropertyAnimation* m_valueAnimation;
-    QTimer* m_indeterminateTimer;
     double m_animatedValue;
     double m_indeterminatePosition;
+    double m_indeterminateTime; // 不确定动画累计时间（秒）
     bool m_isFirstCycle;
     
     // 样式常量
@@ -2,7 +2,6 @@
 
 #include "QWinUI/QWinUIWidget.h"
 #include <QPropertyAnimation>
-#include <QTimer>
 #include <QPainter>
 #include <QPainterPath>
 
@@ -85,9 +84,9 @@ protected:
 
     // 主题处理
     void onThemeChanged() override;
+    QWinUITheme::ColorTokenSet themeColorTokens() const override;
 
 private slots:
-    void updateIndeterminateAnimation();
     void onValueAnimationFinished();
 
 private:
@@ -95,6 +94,7 @@ private:
     void updateColors();
     void startIndeterminateAnimation();
     void stopIndeterminateAnimation();
+    void updateIndeterminateAnimation(qint64 deltaMs);
     void startValueAnimation(double targetValue);
     
     // 绘制方法
@@ -121,7 +121,6 @@ private:
 
     // 动画相关
     QPropertyAnimation* m_valueAnimation;
-    QTimer* m_indeterminateTimer;
     double m_animatedValue;  // 当前动画显示的值
     double m_targetValue;    // 目标值
 
@@ -130,7 +129,6 @@ private:
     double m_indeterminateSpan;
     bool m_indeterminateDirection;
     double m_indeterminatePhase;  // 动画相位
-    qint64 m_lastUpdateTime;      // 上次更新时间
     bool m_animationPaused;       // 动画暂停状态
 
     // 常量
@@ -141,9 +139,8 @@ private:
     static constexpr int DEFAULT_SIZE = 32;
 
     // 动画常量
-    static constexpr int INDETERMINATE_TIMER_INTERVAL = 16; // 60 FPS
     static constexpr int VALUE_ANIMATION_DURATION = 280;    // 确定进度动画时长
-    static constexpr double INDETERMINATE_ROTATION_SPEED = 8.0;  // 旋转速度（度/帧）- 加快
+    static constexpr double INDETERMINATE_ROTATION_SPEED = 480.0; // 旋转速度（度/秒）- 加快
     static constexpr double INDETERMINATE_MIN_SPAN = 8.0;   // 最小弧长
     static constexpr double INDETERMINATE_MAX_SPAN = 80.0;  // 最大弧长
     static constexpr double INDETERMINATE_SPAN_SPEED = 2.5; // 弧长变化速度 - 加快
@@ -110,15 +110,12 @@ protected:
     void enterEvent(QEnterEvent* event) override;
     void leaveEvent(QEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
+    void showEvent(QShowEvent* event) override;
     void contextMenuEvent(QContextMenuEvent* event) override;
 
     // 主题相关
     void onThemeChanged() override;
 
-private slots:
-    void onFadeAnimationFinished();
-    void onAutoHideTimer();
-
 private:
     void initializeScrollBar();
     void updateGeometry();
@@ -151,6 +148,11 @@ private:
     
     // 动画
     void startFadeAnimation(double targetOpacity);
+    void restartAutoHide();
+    void stopAutoHide();
+    void ensureFrameSubscription();
+    void onFrame(qint64 deltaMs);
+    void onAutoHideTimeout();
 
 private:
     Qt::Orientation m_orientation;
@@ -169,8 +171,15 @@ private:
     
     // 自动隐藏
     bool m_autoHide;
-    QTimer* m_autoHideTimer;
-    QPropertyAnimation* m_fadeAnimation;
+    bool m_autoHidePending;
+    qint64 m_idleTime;          // 距上次交互经过的时间（毫秒）
+
+    // 淡入淡出
+    bool m_fading;
+    double m_fadeStartOpacity;
+    double m_fadeTargetOpacity;
+    qint64 m_fadeElapsed;
+    QEasingCurve m_fadeEasing;
     
     // 交互状态
     bool m_sliderDown;
@@ -184,6 +193,10 @@ private:
     mutable QRect m_trackRect;
     mutable QRect m_grooveRect;
     mutable bool m_geometryDirty;
+
+    // 动画常量
+    static constexpr int AUTO_HIDE_DELAY = 1500; // 1.5秒后自动隐藏
+    static constexpr int FADE_DURATION = 150;
 };
 
 QT_END_NAMESPACE
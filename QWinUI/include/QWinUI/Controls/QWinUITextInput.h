@@ -147,17 +147,16 @@ protected:
     void mouseDoubleClickEvent(QMouseEvent* event) override;
     void focusInEvent(QFocusEvent* event) override;
     void focusOutEvent(QFocusEvent* event) override;
+    void showEvent(QShowEvent* event) override;
     void inputMethodEvent(QInputMethodEvent* event) override;
     QVariant inputMethodQuery(Qt::InputMethodQuery query) const override;
     
     // 主题变化处理
     void onThemeChanged() override;
+    QWinUITheme::ColorTokenSet themeColorTokens() const override;
 
 private slots:
-    void onCursorBlink();
     void updateColors();
-    void onCursorVisibilityTimeout();
-    void startCursorFadeOut();
 
 private:
     // 核心方法
@@ -189,10 +188,12 @@ private:
     void addCommand(QWinUITextCommand* command);
 
     // 光标动画控制
-    void initializeCursorAnimation();
     void startCursorAnimation();
     void stopCursorAnimation();
     void resetCursorAnimation();
+    void onCursorFrame(qint64 deltaMs);
+    void holdCursorVisible(int durationMs); // 完全可见阶段不订阅帧时钟，结束后恢复
+    void resumeCursorFrames();
 
 private:
     // 文本数据
@@ -208,13 +209,12 @@ private:
     int m_selectionStart;
     int m_selectionEnd;
     bool m_cursorVisible;
-    QTimer* m_cursorTimer;
 
     // 光标动画
     qreal m_cursorOpacity;
-    QPropertyAnimation* m_cursorAnimation;
-    QTimer* m_cursorVisibilityTimer;
-    bool m_isTyping;
+    qint64 m_cursorPhaseTime; // 当前闪烁周期内经过的时间（毫秒）
+    QEasingCurve m_cursorEasing;
+    QTimer* m_cursorHoldTimer; // 完全可见阶段结束时恢复帧回调
     
     // 状态
     bool m_readOnly;
@@ -241,7 +241,6 @@ private:
     // 常量
     static constexpr int DEFAULT_CURSOR_WIDTH = 1;
     static constexpr int DEFAULT_PADDING = 8;
-    static constexpr int CURSOR_BLINK_INTERVAL = 500;
     static constexpr int CURSOR_VISIBLE_DURATION = 1000;  // 光标完全可见持续时间
     static constexpr int CURSOR_FADE_DURATION = 500;      // 淡入淡出动画时长
 };
@@ -88,7 +88,7 @@ private slots:
     void onHideTimer();
     void onFadeInFinished();
     void onFadeOutFinished();
-    void onThemeChanged();
+    void onThemeChanged() override;
 
 private:
     void initializeToolTip();
@@ -10,6 +10,7 @@
 #include "QWinUIIconConstants.h"
 #include "QWinUIFluentIcons.h"
 #include "QWinUIAnimation.h"
+#include "QWinUIFrameClock.h"
 #include "QWinUIBlurEffect.h"
 
 // Controls
@@ -10,155 +10,350 @@ namespace QWinUIFluentIcons {
 
     // 导航图标
     namespace Navigation {
-        inline const QChar HOME = QChar(0xE80F);
-        inline const QChar BACK = QChar(0xE72B);
-        inline const QChar FORWARD = QChar(0xE72A);
-        inline const QChar REFRESH = QChar(0xE72C);
-        inline const QChar SEARCH = QChar(0xE721);
-        inline const QChar MENU = QChar(0xE700);
-        inline const QChar MORE = QChar(0xE712);
-        inline const QChar CLOSE = QChar(0xE8BB);
+        inline constexpr QChar HOME = QChar(0xE80F);
+        inline constexpr QChar BACK = QChar(0xE72B);
+        inline constexpr QChar FORWARD = QChar(0xE72A);
+        inline constexpr QChar REFRESH = QChar(0xE72C);
+        inline constexpr QChar SEARCH = QChar(0xE721);
+        inline constexpr QChar MENU = QChar(0xE700);
+        inline constexpr QChar MORE = QChar(0xE712);
+        inline constexpr QChar CLOSE = QChar(0xE8BB);
     }
 
     // 操作图标
     namespace Actions {
-        inline const QChar ADD = QChar(0xE710);
-        inline const QChar REMOVE = QChar(0xE738);
-        inline const QChar DELETE_ICON = QChar(0xE74D);
-        inline const QChar EDIT = QChar(0xE70F);
-        inline const QChar SAVE = QChar(0xE74E);
-        inline const QChar OPEN = QChar(0xE8E5);
-        inline const QChar COPY = QChar(0xE8C8);
-        inline const QChar PASTE = QChar(0xE77F);
-        inline const QChar CUT = QChar(0xE8C6);
-        inline const QChar UNDO = QChar(0xE7A7);
-        inline const QChar REDO = QChar(0xE7A6);
-        inline const QChar SHARE = QChar(0xE72D);
-        inline const QChar DOWNLOAD = QChar(0xE896);
-        inline const QChar UPLOAD = QChar(0xE898);
+        inline constexpr QChar ADD = QChar(0xE710);
+        inline constexpr QChar REMOVE = QChar(0xE738);
+        inline constexpr QChar DELETE_ICON = QChar(0xE74D);
+        inline constexpr QChar EDIT = QChar(0xE70F);
+        inline constexpr QChar SAVE = QChar(0xE74E);
+        inline constexpr QChar OPEN = QChar(0xE8E5);
+        inline constexpr QChar COPY = QChar(0xE8C8);
+        inline constexpr QChar PASTE = QChar(0xE77F);
+        inline constexpr QChar CUT = QChar(0xE8C6);
+        inline constexpr QChar UNDO = QChar(0xE7A7);
+        inline constexpr QChar REDO = QChar(0xE7A6);
+        inline constexpr QChar SHARE = QChar(0xE72D);
+        inline constexpr QChar DOWNLOAD = QChar(0xE896);
+        inline constexpr QChar UPLOAD = QChar(0xE898);
     }
 
     // 媒体图标
     namespace Media {
-        inline const QChar PLAY = QChar(0xE768);
-        inline const QChar PAUSE = QChar(0xE769);
-        inline const QChar STOP = QChar(0xE71A);
-        inline const QChar VOLUME = QChar(0xE767);
-        inline const QChar MUTE = QChar(0xE74F);
-        inline const QChar CAMERA = QChar(0xE722);
-        inline const QChar PICTURE = QChar(0xE91B);
-        inline const QChar VIDEO = QChar(0xE714);
-        inline const QChar MUSIC = QChar(0xE8D6);
-        inline const QChar MICROPHONE = QChar(0xE720);
+        inline constexpr QChar PLAY = QChar(0xE768);
+        inline constexpr QChar PAUSE = QChar(0xE769);
+        inline constexpr QChar STOP = QChar(0xE71A);
+        inline constexpr QChar VOLUME = QChar(0xE767);
+        inline constexpr QChar MUTE = QChar(0xE74F);
+        inline constexpr QChar CAMERA = QChar(0xE722);
+        inline constexpr QChar PICTURE = QChar(0xE91B);
+        inline constexpr QChar VIDEO = QChar(0xE714);
+        inline constexpr QChar MUSIC = QChar(0xE8D6);
+        inline constexpr QChar MICROPHONE = QChar(0xE720);
     }
 
     // 文件和文档
     namespace Files {
-        inline const QChar FOLDER = QChar(0xE8B7);
-        inline const QChar FILE_ICON = QChar(0xE8A5);
-        inline const QChar DOCUMENT = QChar(0xE8A5);
-        inline const QChar ATTACH = QChar(0xE723);
-        inline const QChar LINK = QChar(0xE71B);
+        inline constexpr QChar FOLDER = QChar(0xE8B7);
+        inline constexpr QChar FILE_ICON = QChar(0xE8A5);
+        inline constexpr QChar DOCUMENT = QChar(0xE8A5);
+        inline constexpr QChar ATTACH = QChar(0xE723);
+        inline constexpr QChar LINK = QChar(0xE71B);
     }
 
     // 通信图标
     namespace Communication {
-        inline const QChar MAIL = QChar(0xE715);
-        inline const QChar MESSAGE = QChar(0xE8BD);
-        inline const QChar PHONE = QChar(0xE717);
-        inline const QChar CONTACT = QChar(0xE77B);
-        inline const QChar PEOPLE = QChar(0xE716);
+        inline constexpr QChar MAIL = QChar(0xE715);
+        inline constexpr QChar MESSAGE = QChar(0xE8BD);
+        inline constexpr QChar PHONE = QChar(0xE717);
+        inline constexpr QChar CONTACT = QChar(0xE77B);
+        inline constexpr QChar PEOPLE = QChar(0xE716);
     }
 
     // 系统图标
     namespace System {
-        inline const QChar SETTINGS = QChar(0xE713);
-        inline const QChar POWER = QChar(0xE7E8);
-        inline const QChar LOCK = QChar(0xE72E);
-        inline const QChar UNLOCK = QChar(0xE785);
-        inline const QChar WIFI = QChar(0xE701);
-        inline const QChar BLUETOOTH = QChar(0xE702);
-        inline const QChar BATTERY = QChar(0xE83F);
-        inline const QChar KEYBOARD = QChar(0xE765);
-        inline const QChar MOUSE = QChar(0xE962);
-        inline const QChar PRINT = QChar(0xE749);
+        inline constexpr QChar SETTINGS = QChar(0xE713);
+        inline constexpr QChar POWER = QChar(0xE7E8);
+        inline constexpr QChar LOCK = QChar(0xE72E);
+        inline constexpr QChar UNLOCK = QChar(0xE785);
+        inline constexpr QChar WIFI = QChar(0xE701);
+        inline constexpr QChar BLUETOOTH = QChar(0xE702);
+        inline constexpr QChar BATTERY = QChar(0xE83F);
+        inline constexpr QChar KEYBOARD = QChar(0xE765);
+        inline constexpr QChar MOUSE = QChar(0xE962);
+        inline constexpr QChar PRINT = QChar(0xE749);
     }
 
     // 状态图标
     namespace Status {
-        inline const QChar FAVORITE = QChar(0xE734);
-        inline const QChar HEART = QChar(0xE734);
-        inline const QChar STAR = QChar(0xE735);
-        inline const QChar BOOKMARK = QChar(0xE8A4);
-        inline const QChar FLAG = QChar(0xE7C1);
-        inline const QChar TAG = QChar(0xE8EC);
-        inline const QChar CHECK = QChar(0xE73E);
-        inline const QChar CANCEL = QChar(0xE711);
-        inline const QChar WARNING = QChar(0xE7BA);
-        inline const QChar ERROR_ICON = QChar(0xE783);
-        inline const QChar INFO = QChar(0xE946);
-        inline const QChar HELP = QChar(0xE897);
+        inline constexpr QChar FAVORITE = QChar(0xE734);
+        inline constexpr QChar HEART = QChar(0xE734);
+        inline constexpr QChar STAR = QChar(0xE735);
+        inline constexpr QChar BOOKMARK = QChar(0xE8A4);
+        inline constexpr QChar FLAG = QChar(0xE7C1);
+        inline constexpr QChar TAG = QChar(0xE8EC);
+        inline constexpr QChar CHECK = QChar(0xE73E);
+        inline constexpr QChar CANCEL = QChar(0xE711);
+        inline constexpr QChar WARNING = QChar(0xE7BA);
+        inline constexpr QChar ERROR_ICON = QChar(0xE783);
+        inline constexpr QChar INFO = QChar(0xE946);
+        inline constexpr QChar HELP = QChar(0xE897);
     }
 
     // 箭头图标
     namespace Arrows {
-        inline const QChar ARROW_UP = QChar(0xE70E);
-        inline const QChar ARROW_DOWN = QChar(0xE70D);
-        inline const QChar ARROW_LEFT = QChar(0xE70C);
-        inline const QChar ARROW_RIGHT = QChar(0xE70B);
-        inline const QChar CHEVRON_UP = QChar(0xE70E);
-        inline const QChar CHEVRON_DOWN = QChar(0xE70D);
-        inline const QChar CHEVRON_LEFT = QChar(0xE76B);
-        inline const QChar CHEVRON_RIGHT = QChar(0xE76C);
+        inline constexpr QChar ARROW_UP = QChar(0xE70E);
+        inline constexpr QChar ARROW_DOWN = QChar(0xE70D);
+        inline constexpr QChar ARROW_LEFT = QChar(0xE70C);
+        inline constexpr QChar ARROW_RIGHT = QChar(0xE70B);
+        inline constexpr QChar CHEVRON_UP = QChar(0xE70E);
+        inline constexpr QChar CHEVRON_DOWN = QChar(0xE70D);
+        inline constexpr QChar CHEVRON_LEFT = QChar(0xE76B);
+        inline constexpr QChar CHEVRON_RIGHT = QChar(0xE76C);
     }
 
     // 视图图标
     namespace View {
-        inline const QChar LIST = QChar(0xE8FD);
-        inline const QChar GRID = QChar(0xE80A);
-        inline const QChar VIEW_ICON = QChar(0xE890);
-        inline const QChar FILTER = QChar(0xE71C);
-        inline const QChar SORT = QChar(0xE8CB);
-        inline const QChar ZOOM_IN = QChar(0xE8A3);
-        inline const QChar ZOOM_OUT = QChar(0xE71F);
-        inline const QChar FULL_SCREEN = QChar(0xE740);
-        inline const QChar MINIMIZE = QChar(0xE921);
-        inline const QChar MAXIMIZE = QChar(0xE922);
-        inline const QChar RESTORE = QChar(0xE923);
+        inline constexpr QChar LIST = QChar(0xE8FD);
+        inline constexpr QChar GRID = QChar(0xE80A);
+        inline constexpr QChar VIEW_ICON = QChar(0xE890);
+        inline constexpr QChar FILTER = QChar(0xE71C);
+        inline constexpr QChar SORT = QChar(0xE8CB);
+        inline constexpr QChar ZOOM_IN = QChar(0xE8A3);
+        inline constexpr QChar ZOOM_OUT = QChar(0xE71F);
+        inline constexpr QChar FULL_SCREEN = QChar(0xE740);
+        inline constexpr QChar MINIMIZE = QChar(0xE921);
+        inline constexpr QChar MAXIMIZE = QChar(0xE922);
+        inline constexpr QChar RESTORE = QChar(0xE923);
     }
 
     // 时间和位置
     namespace TimeLocation {
-        inline const QChar CALENDAR = QChar(0xE787);
-        inline const QChar CLOCK = QChar(0xE823);
-        inline const QChar GLOBE = QChar(0xE774);
-        inline const QChar LOCATION = QChar(0xE81D);
-        inline const QChar MAP = QChar(0xE707);
+        inline constexpr QChar CALENDAR = QChar(0xE787);
+        inline constexpr QChar CLOCK = QChar(0xE823);
+        inline constexpr QChar GLOBE = QChar(0xE774);
+        inline constexpr QChar LOCATION = QChar(0xE81D);
+        inline constexpr QChar MAP = QChar(0xE707);
     }
 
     // 交通工具
     namespace Transport {
-        inline const QChar CAR = QChar(0xE804);
-        inline const QChar AIRPLANE = QChar(0xE709);
-        inline const QChar TRAIN = QChar(0xE7C0);
+        inline constexpr QChar CAR = QChar(0xE804);
+        inline constexpr QChar AIRPLANE = QChar(0xE709);
+        inline constexpr QChar TRAIN = QChar(0xE7C0);
     }
 
     // 购物和金融
     namespace Shopping {
-        inline const QChar SHOPPING = QChar(0xE7BF);
-        inline const QChar CART = QChar(0xE7BF);
-        inline const QChar MONEY = QChar(0xE8D4);
-        inline const QChar CALCULATOR = QChar(0xE8EF);
+        inline constexpr QChar SHOPPING = QChar(0xE7BF);
+        inline constexpr QChar CART = QChar(0xE7BF);
+        inline constexpr QChar MONEY = QChar(0xE8D4);
+        inline constexpr QChar CALCULATOR = QChar(0xE8EF);
+    }
+
+    // 名称到字符的编译期映射
+    // 名称经带种子的 FNV-1a 散列到 4096 个槽位，种子在编译期搜索到使所有名称互不冲突为止，
+    // 查询只需一次散列、一次查表和一次名称比较
+    namespace Detail {
+        struct NameEntry {
+            const char* name; // 小写ASCII
+            QChar glyph;
+        };
+
+        inline constexpr NameEntry NAME_TABLE[] = {
+            {"home", Navigation::HOME},
+            {"settings", System::SETTINGS},
+            {"search", Navigation::SEARCH},
+            {"add", Actions::ADD},
+            {"remove", Actions::REMOVE},
+            {"delete", Actions::DELETE_ICON},
+            {"edit", Actions::EDIT},
+            {"save", Actions::SAVE},
+            {"open", Actions::OPEN},
+            {"close", Navigation::CLOSE},
+            {"back", Navigation::BACK},
+            {"forward", Navigation::FORWARD},
+            {"refresh", Navigation::REFRESH},
+            {"download", Actions::DOWNLOAD},
+            {"upload", Actions::UPLOAD},
+            {"copy", Actions::COPY},
+            {"paste", Actions::PASTE},
+            {"cut", Actions::CUT},
+            {"undo", Actions::UNDO},
+            {"redo", Actions::REDO},
+            {"play", Media::PLAY},
+            {"pause", Media::PAUSE},
+            {"stop", Media::STOP},
+            {"volume", Media::VOLUME},
+            {"mute", Media::MUTE},
+            {"favorite", Status::FAVORITE},
+            {"heart", Status::HEART},
+            {"star", Status::STAR},
+            {"bookmark", Status::BOOKMARK},
+            {"folder", Files::FOLDER},
+            {"file", Files::FILE_ICON},
+            {"document", Files::DOCUMENT},
+            {"mail", Communication::MAIL},
+            {"message", Communication::MESSAGE},
+            {"phone", Communication::PHONE},
+            {"contact", Communication::CONTACT},
+            {"calendar", TimeLocation::CALENDAR},
+            {"clock", TimeLocation::CLOCK},
+            {"camera", Media::CAMERA},
+            {"picture", Media::PICTURE},
+            {"video", Media::VIDEO},
+            {"music", Media::MUSIC},
+            {"microphone", Media::MICROPHONE},
+            {"speaker", QChar(0xE7F5)},
+            {"wifi", System::WIFI},
+            {"bluetooth", System::BLUETOOTH},
+            {"battery", System::BATTERY},
+            {"power", System::POWER},
+            {"lock", System::LOCK},
+            {"unlock", System::UNLOCK},
+            {"user", Communication::CONTACT},
+            {"people", Communication::PEOPLE},
+            {"globe", TimeLocation::GLOBE},
+            {"location", TimeLocation::LOCATION},
+            {"map", TimeLocation::MAP},
+            {"car", Transport::CAR},
+            {"airplane", Transport::AIRPLANE},
+            {"train", Transport::TRAIN},
+            {"shopping", Shopping::SHOPPING},
+            {"cart", Shopping::CART},
+            {"money", Shopping::MONEY},
+            {"calculator", Shopping::CALCULATOR},
+            {"keyboard", System::KEYBOARD},
+            {"mouse", System::MOUSE},
+            {"print", System::PRINT},
+            {"scan", QChar(0xE8FE)},
+            {"share", Actions::SHARE},
+            {"link", Files::LINK},
+            {"attach", Files::ATTACH},
+            {"flag", Status::FLAG},
+            {"tag", Status::TAG},
+            {"filter", View::FILTER},
+            {"sort", View::SORT},
+            {"view", View::VIEW_ICON},
+            {"list", View::LIST},
+            {"grid", View::GRID},
+            {"zoom_in", View::ZOOM_IN},
+            {"zoom_out", View::ZOOM_OUT},
+            {"full_screen", View::FULL_SCREEN},
+            {"minimize", View::MINIMIZE},
+            {"maximize", View::MAXIMIZE},
+            {"restore", View::RESTORE},
+            {"help", Status::HELP},
+            {"info", Status::INFO},
+            {"warning", Status::WARNING},
+            {"error", Status::ERROR_ICON},
+            {"success", Status::CHECK},
+            {"check", Status::CHECK},
+            {"cancel", Status::CANCEL},
+            {"clear", QChar(0xE894)},
+            {"more", Navigation::MORE},
+            {"menu", Navigation::MENU},
+            {"hamburger", Navigation::MENU},
+            {"dots", Navigation::MORE},
+            {"arrow_up", Arrows::ARROW_UP},
+            {"arrow_down", Arrows::ARROW_DOWN},
+            {"arrow_left", Arrows::ARROW_LEFT},
+            {"arrow_right", Arrows::ARROW_RIGHT},
+            {"chevron_up", Arrows::CHEVRON_UP},
+            {"chevron_down", Arrows::CHEVRON_DOWN},
+            {"chevron_left", Arrows::CHEVRON_LEFT},
+            {"chevron_right", Arrows::CHEVRON_RIGHT}
+        };
+
+        inline constexpr int NAME_COUNT = int(sizeof(NAME_TABLE) / sizeof(NAME_TABLE[0]));
+        inline constexpr int NAME_SLOT_BITS = 12;
+        inline constexpr int NAME_SLOT_COUNT = 1 << NAME_SLOT_BITS;
+        static_assert(NAME_COUNT < 255, "NameSlots 使用 quint8 存储表项序号");
+
+        constexpr int nameLength(const char* name) {
+            int length = 0;
+            while (name[length] != '\0') {
+                ++length;
+            }
+            return length;
+        }
+
+        // 编译期（char）和运行时（UTF-16）共用；ASCII大写折叠为小写，查询不区分大小写
+        template <typename Char>
+        constexpr quint32 hashName(const Char* name, int length, quint32 seed) {
+            quint32 hash = 2166136261u ^ seed;
+            for (int i = 0; i < length; ++i) {
+                quint32 c = quint32(name[i]) & 0xFFFFu;
+                if (c >= 'A' && c <= 'Z') {
+                    c += 'a' - 'A';
+                }
+                hash = (hash ^ c) * 16777619u;
+            }
+            // 末尾混合，让高位也参与槽位选择
+            hash ^= hash >> 16;
+            hash *= 0x45D9F3Bu;
+            hash ^= hash >> 16;
+            return hash;
+        }
+
+        constexpr int nameSlot(quint32 hash) {
+            return int(hash & quint32(NAME_SLOT_COUNT - 1));
+        }
+
+        constexpr bool isPerfectSeed(quint32 seed) {
+            bool used[NAME_SLOT_COUNT] = {};
+            for (int i = 0; i < NAME_COUNT; ++i) {
+                const int slot = nameSlot(hashName(NAME_TABLE[i].name, nameLength(NAME_TABLE[i].name), seed));
+                if (used[slot]) {
+                    return false;
+                }
+                used[slot] = true;
+            }
+            return true;
+        }
+
+        constexpr quint32 findPerfectSeed() {
+            quint32 seed = 0;
+            while (!isPerfectSeed(seed)) {
+                ++seed;
+            }
+            return seed;
+        }
+
+        inline constexpr quint32 NAME_SEED = findPerfectSeed();
+
+        struct NameSlots {
+            quint8 entry[NAME_SLOT_COUNT]; // 表项序号加一，0 表示空槽
+        };
+
+        constexpr NameSlots buildNameSlots() {
+            NameSlots slots = {};
+            for (int i = 0; i < NAME_COUNT; ++i) {
+                const int slot = nameSlot(hashName(NAME_TABLE[i].name, nameLength(NAME_TABLE[i].name), NAME_SEED));
+                slots.entry[slot] = quint8(i + 1);
+            }
+            return slots;
+        }
+
+        inline constexpr NameSlots NAME_SLOTS = buildNameSlots();
     }
 
     // 便捷方法
     namespace Utils {
-        // 根据图标名称获取字符
+        // 根据图标名称获取字符（不区分大小写），未知名称返回空字符
         inline QChar getIconChar(const QString& iconName) {
-            // 这里可以实现名称到字符的映射
-            // 暂时返回空字符，具体实现在QWinUIIcon中
-            Q_UNUSED(iconName)
-            return QChar();
+            const quint32 hash = Detail::hashName(iconName.utf16(), int(iconName.size()), Detail::NAME_SEED);
+            const int entry = Detail::NAME_SLOTS.entry[Detail::nameSlot(hash)];
+            if (entry == 0) {
+                return QChar();
+            }
+
+            // 不在表中的名称也可能落到已占用的槽位，需要比较名称
+            const Detail::NameEntry& candidate = Detail::NAME_TABLE[entry - 1];
+            if (iconName.compare(QLatin1String(candidate.name), Qt::CaseInsensitive) != 0) {
+                return QChar();
+            }
+            return candidate.glyph;
         }
     }
 
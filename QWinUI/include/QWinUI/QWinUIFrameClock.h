@@ -0,0 +1,80 @@
+#ifndef QWINUIFRAMECLOCK_H
+#define QWINUIFRAMECLOCK_H
+
+#include "QWinUIGlobal.h"
+#include <QObject>
+#include <QHash>
+#include <QPointer>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QWidget>
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+// 进程级共享帧时钟
+// 所有需要逐帧动画的控件订阅同一个时钟：每个显示帧只唤醒一次，
+// 回调参数为距上一帧经过的毫秒数，动画按时间推进而不是按帧计数。
+// 不可见或窗口未暴露的订阅者暂停但保留订阅，控件重新显示或窗口重新暴露时恢复；
+// 没有订阅者或所有订阅者都暂停时时钟停止。
+class QWINUI_EXPORT QWinUIFrameClock : public QObject
+{
+    Q_OBJECT
+
+public:
+    using FrameCallback = std::function<void(qint64 deltaMs)>;
+
+    static QWinUIFrameClock* getInstance();
+    static void destroyInstance();
+
+    // 订阅管理（同一控件重复订阅会替换回调）
+    void subscribe(QWidget* subscriber, FrameCallback callback);
+    void unsubscribe(QWidget* subscriber);
+    bool isSubscribed(const QWidget* subscriber) const;
+    int subscriberCount() const;
+
+    // 时钟状态
+    bool isRunning() const;
+    int frameInterval() const;
+
+signals:
+    void runningChanged(bool running);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private slots:
+    void onFrame();
+
+private:
+    explicit QWinUIFrameClock(QObject* parent = nullptr);
+    ~QWinUIFrameClock();
+
+    void start();
+    void stop();
+    void updateFrameInterval();
+    static bool isSubscriberActive(const QWidget* widget);
+    void watchForResume(QWidget* widget);
+
+    struct Subscriber {
+        QPointer<QWidget> widget;
+        FrameCallback callback;
+        bool paused = false; // 不可见或未暴露，等待恢复
+    };
+
+    static QWinUIFrameClock* s_instance;
+
+    QHash<const QWidget*, Subscriber> m_subscribers;
+    QTimer m_timer;
+    QElapsedTimer m_elapsed;
+    qint64 m_lastFrameTime;
+
+    static constexpr int DEFAULT_FRAME_INTERVAL = 16; // ~60 FPS
+    static constexpr qint64 MAX_FRAME_DELTA = 100;    // 长时间阻塞后避免动画跳变过大
+
+    Q_DISABLE_COPY(QWinUIFrameClock)
+};
+
+QT_END_NAMESPACE
+
+#endif // QWINUIFRAMECLOCK_H
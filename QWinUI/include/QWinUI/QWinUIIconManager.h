@@ -4,14 +4,29 @@
 #include <QObject>
 #include <QSvgRenderer>
 #include <QPixmap>
+#include <QImage>
+#include <QPainterPath>
+#include <QBrush>
+#include <QPen>
+#include <QTransform>
 #include <QColor>
 #include <QHash>
+#include <QCache>
 #include <QStringList>
 #include <QMutex>
+#include <QReadWriteLock>
+#include <QWaitCondition>
+#include <QSet>
+#include <QAtomicPointer>
+#include <QThreadPool>
+#include <atomic>
 #include <QDir>
+#include <QFile>
 
 QT_BEGIN_NAMESPACE
 
+class QPainter;
+
 // 图标信息结构
 struct QWinUIIconInfo {
     QString name;
@@ -25,16 +40,54 @@ struct QWinUIIconInfo {
         : name(iconName), filePath(path), category(cat) {}
 };
 
-// 图标缓存项
+// 图标光栅缓存项（同一图标的每种尺寸各占一项，共享同一份解析后的SVG文档）
+// 着色请求只缓存8位alpha遮罩，绘制时再按颜色填充，所有颜色共用同一份遮罩。
+// 缓存只保存 QImage，可在任意线程读写；QPixmap 只在GUI线程按需转换
 struct QWinUIIconCacheItem {
-    QSvgRenderer* renderer;
-    QPixmap pixmap;
-    QColor lastColor;
+    QImage image;   // 未着色请求：Format_ARGB32_Premultiplied 图像
+    QImage mask;    // 着色请求：Format_Alpha8 遮罩
     QSize lastSize;
-    qint64 lastAccessed;
+    qint64 byteSize; // 计入缓存字节预算的像素数据大小
     
-    QWinUIIconCacheItem() : renderer(nullptr), lastAccessed(0) {}
-    ~QWinUIIconCacheItem() { delete renderer; }
+    QWinUIIconCacheItem() : byteSize(0) {}
+};
+
+// 图标矢量图层：SVG绘制时的一次填充或描边，路径在 transform 所在的坐标系中
+struct QWinUIIconVectorLayer {
+    QPainterPath path;
+    QBrush brush;
+    QPen pen;
+    QTransform transform;
+    qreal opacity;
+
+    QWinUIIconVectorLayer() : opacity(1.0) {}
+};
+
+// 图标矢量数据：按绘制顺序排列的图层，坐标范围为 (0, 0) 到 size
+// 旋转、缩放等动画直接按变换绘制路径，不需要重新光栅化或遍历SVG文档
+struct QWinUIIconVector {
+    QSizeF size;
+    QList<QWinUIIconVectorLayer> layers;
+
+    bool isValid() const { return !size.isEmpty() && !layers.isEmpty(); }
+};
+
+// 图标缓存统计
+struct QWinUIIconCacheStats {
+    quint64 documentHits;    // 已解析SVG文档命中次数
+    quint64 documentMisses;  // 需要解析SVG文件的次数
+    quint64 rasterHits;      // 光栅图命中次数
+    quint64 rasterMisses;    // 需要重新光栅化的次数
+    quint64 rasterEvictions; // 超出数量或字节预算被淘汰的光栅图数量
+    quint64 rasterWaits;     // 等待其他线程完成同一光栅化的次数
+    int documentCount;
+    int rasterCount;
+    qint64 rasterBytes;      // 光栅缓存当前占用的字节数
+    qint64 rasterByteLimit;
+
+    QWinUIIconCacheStats()
+        : documentHits(0), documentMisses(0), rasterHits(0), rasterMisses(0), rasterEvictions(0), rasterWaits(0)
+        , documentCount(0), rasterCount(0), rasterBytes(0), rasterByteLimit(0) {}
 };
 
 class QWINUI_EXPORT QWinUIIconManager : public QObject
@@ -45,58 +98,316 @@ public:
     static QWinUIIconManager* getInstance();
     
     // 图标加载和管理
+    // 目录扫描结果写入缓存目录中的清单；清单记录的各级目录修改时间未变时直接按清单注册，
+    // 不逐个读取SVG文件。目录有变化时先按旧清单注册，再在后台重新扫描，只注册增删改的图标
     bool loadIconsFromDirectory(const QString& directory);
     bool loadIconsFromResources(const QString& resourcePrefix = ":/icons");
     bool registerIcon(const QString& name, const QString& filePath, const QString& category = QString());
     bool registerResourceIcon(const QString& name, const QString& resourcePath, const QString& category = QString());
     void unregisterIcon(const QString& name);
     
+    // 图标包（由 scripts/generate_icons_qrc.py --pack 在构建时生成）
+    // 以内存映射方式加载，按名称 O(1) 查找，路径数据已预先解析，启动时不解析任何SVG。
+    // 图标包中的图标可按名称（如 "solid/house"）或资源路径（如 ":/icons/solid/house"）访问。
+    bool loadIconPack(const QString& packFile);
+    void unloadIconPack();
+    bool hasIconPack() const;
+    int getIconPackSize() const;
+    // 依次查找环境变量 QWINUI_ICON_PACK、可执行文件所在目录、库的安装目录、库的构建目录，都不存在时返回可执行文件旁的路径
+    static QString defaultIconPackPath();
+    
     // 图标查询
+    // 名称、分类和标签查询走同一份索引：首次查询时构建，注册图标或加载图标包后失效，
+    // 构建时不读取SVG内容。结果按名称排序，标签来自图标信息以及名称中以 '-' 分隔的单词。
     bool hasIcon(const QString& name) const;
     QWinUIIconInfo getIconInfo(const QString& name) const;
     QStringList getIconNames() const;
     QStringList getIconsByCategory(const QString& category) const;
     QStringList getIconsByTag(const QString& tag) const;
     QStringList getCategories() const;
+    // 前缀匹配完整名称（如 "solid/arr"）或基础名称（如 "arr"），不区分大小写；limit < 0 表示不限数量
+    QStringList findIconsByPrefix(const QString& prefix, int limit = -1) const;
+    // 子串匹配完整名称，不区分大小写
+    QStringList findIconsContaining(const QString& text, int limit = -1) const;
     
     // 图标渲染
+    // size 为逻辑尺寸，按 devicePixelRatio 光栅化到设备像素，返回的图像已设置对应的设备像素比。
+    // 返回 QPixmap 的接口只能在GUI线程调用，工作线程使用 getIconImage / getIconImageFromFile
     QPixmap getIcon(const QString& name, const QSize& size = QSize(16, 16), 
-                   const QColor& color = QColor()) const;
+                   const QColor& color = QColor(), qreal devicePixelRatio = 1.0) const;
+    // 直接按SVG文件或资源路径渲染（无需注册），与 getIcon 共用同一套缓存
+    QPixmap getIconFromFile(const QString& filePath, const QSize& size = QSize(16, 16),
+                            const QColor& color = QColor(), qreal devicePixelRatio = 1.0) const;
+    // 与 getIcon / getIconFromFile 相同，返回 Format_ARGB32_Premultiplied 图像，可在任意线程调用
+    QImage getIconImage(const QString& name, const QSize& size = QSize(16, 16),
+                        const QColor& color = QColor(), qreal devicePixelRatio = 1.0) const;
+    QImage getIconImageFromFile(const QString& filePath, const QSize& size = QSize(16, 16),
+                                const QColor& color = QColor(), qreal devicePixelRatio = 1.0) const;
+    
+    // 异步渲染：命中缓存时直接返回最终结果；未命中时立即返回占位图（同一图标已缓存的最接近尺寸
+    // 缩放得到，没有则为透明图），在线程池中光栅化，完成后发出 iconReady。
+    // ready 返回结果是否为最终图像。只能在GUI线程调用。
+    QPixmap requestIcon(const QString& name, const QSize& size = QSize(16, 16),
+                        const QColor& color = QColor(), qreal devicePixelRatio = 1.0, bool* ready = nullptr) const;
+    QPixmap requestIconFromFile(const QString& filePath, const QSize& size = QSize(16, 16),
+                                const QColor& color = QColor(), qreal devicePixelRatio = 1.0, bool* ready = nullptr) const;
+    // 在后台预先光栅化一组图标，已缓存或正在光栅化的图标会被跳过
+    void prefetchIcons(const QStringList& names, const QSize& size = QSize(16, 16),
+                       const QColor& color = QColor(), qreal devicePixelRatio = 1.0) const;
+    // 同时运行的后台光栅化任务上限，超出的请求排队，最近的请求优先
+    void setMaxAsyncJobs(int maxJobs);
+    int maxAsyncJobs() const;
+    
     QSvgRenderer* getRenderer(const QString& name) const;
+    // 文件存在或可由图标包解析
+    bool hasIconFile(const QString& filePath) const;
+    // SVG数据（图标包中的图标按预解析的路径重新生成）
+    QByteArray getIconData(const QString& filePath) const;
+    
+    // 矢量路径：每个SVG只提取一次，与SVG文档共用缓存上限
+    QWinUIIconVector getIconVector(const QString& name) const;
+    QWinUIIconVector getIconVectorFromFile(const QString& filePath) const;
+    
+    // 字体图标轮廓：按字体、字符和像素尺寸缓存，原点位于字形行框中心（与 drawText 的 AlignCenter 对齐）。
+    // 字体不可用或不含该字符时返回空路径，调用方退回 drawText
+    QPainterPath getGlyphPath(const QString& fontFamily, QChar glyph, int pixelSize) const;
     
     // 缓存管理
+    // 缓存分为两层：每个图标一份解析后的SVG文档，以及按尺寸区分的光栅图。
+    // 光栅图按最近使用顺序淘汰，同时受数量上限和字节预算约束。
+    // 光栅缓存按键分片加锁，不同线程的命中互不阻塞；同一键的未命中只由一个线程光栅化，其余线程等待结果。
     void clearCache();
     void clearCache(const QString& name);
     void setCacheLimit(int maxItems);
     int getCacheSize() const;
+    void setCacheByteLimit(qint64 maxBytes);
+    qint64 getCacheByteLimit() const;
+    qint64 getCacheBytes() const;
+    void setDocumentCacheLimit(int maxDocuments);
+    int getDocumentCacheSize() const;
+    QWinUIIconCacheStats getCacheStats() const;
+    void resetCacheStats();
     
     // 工具方法
     static QPixmap colorizePixmap(const QPixmap& pixmap, const QColor& color);
+    // 用颜色填充alpha遮罩，返回 Format_ARGB32_Premultiplied 图像并保留设备像素比
+    static QImage tintAlphaMask(const QImage& mask, const QColor& color);
     static QString getIconNameFromPath(const QString& filePath);
+    // 把矢量图标绘制到 target（逻辑坐标，受画笔当前变换影响）；color 有效时按该颜色着色并保留各图层的透明度
+    static void drawIconVector(QPainter* painter, const QWinUIIconVector& vector, const QRectF& target,
+                               const QColor& color = QColor());
 
 signals:
     void iconRegistered(const QString& name);
     void iconUnregistered(const QString& name);
     void cacheCleared();
+    // 后台光栅化完成，filePath 为图标的文件或资源路径（按名称请求时与 getIconInfo().filePath 一致）。
+    // image 为缓存中的光栅图：着色请求是 Format_Alpha8 遮罩，需用 tintAlphaMask 着色；
+    // 接收方直接使用该图像，不必再次查询缓存
+    void iconReady(const QString& filePath, const QSize& size, qreal devicePixelRatio, const QImage& image);
+    // 后台重新扫描图标目录后，已按变化增删图标
+    void iconDirectoryUpdated(const QString& directory);
 
 private:
     explicit QWinUIIconManager(QObject* parent = nullptr);
     ~QWinUIIconManager();
     
-    void cleanupCache() const;
-    QString getCacheKey(const QString& name, const QSize& size, const QColor& color) const;
+    // 光栅缓存键（source 为SVG文件路径，同一文件注册为多个名称时共享缓存）
+    // 颜色不参与键值：着色请求共用同一份遮罩
+    struct RasterKey {
+        QString source;
+        QSize size;
+        bool colorize;
+        int dprPercent; // 设备像素比 × 100，避免浮点比较
+
+        bool operator==(const RasterKey& other) const {
+            return source == other.source && size == other.size
+                && colorize == other.colorize
+                && dprPercent == other.dprPercent;
+        }
+    };
+    friend size_t qHash(const RasterKey& key, size_t seed) {
+        return qHashMulti(seed, key.source, key.size.width(), key.size.height(),
+                          key.colorize, key.dprPercent);
+    }
+
+    // 图标目录清单
+    struct ManifestEntry {
+        QString relativePath;
+        qint64 size;
+        qint64 modified; // 毫秒时间戳
+        QString name;
+        QString category;
+        QSize originalSize;
+    };
+    struct IconManifest {
+        QString directory;
+        QHash<QString, qint64> directories; // 相对目录路径 → 修改时间，用于判断清单是否过期
+        QList<ManifestEntry> entries;
+    };
+    static QString manifestPath(const QString& directory);
+    static bool readManifest(const QString& directory, IconManifest* manifest);
+    static bool writeManifest(const IconManifest& manifest);
+    static bool isManifestCurrent(const IconManifest& manifest);
+    // 未变化（大小和修改时间相同）的文件沿用 previous 中的信息，不重新解析SVG；可在工作线程调用
+    static IconManifest scanIconDirectory(const QString& directory, const IconManifest& previous);
+    void registerManifestEntry(const QString& directory, const ManifestEntry& entry);
+    void rescanIconDirectory(const IconManifest& previous);
+    void applyManifestDelta(const IconManifest& previous, const IconManifest& current);
+
+    // 字形轮廓缓存键
+    struct GlyphKey {
+        QString family;
+        char16_t glyph;
+        int pixelSize;
+
+        bool operator==(const GlyphKey& other) const {
+            return glyph == other.glyph && pixelSize == other.pixelSize && family == other.family;
+        }
+    };
+    friend size_t qHash(const GlyphKey& key, size_t seed) {
+        return qHashMulti(seed, key.family, key.glyph, key.pixelSize);
+    }
+
+    // 光栅缓存节点：串成侵入式双向链表，表头为最近使用，表尾最先淘汰
+    struct RasterNode {
+        RasterKey key;
+        QWinUIIconCacheItem item;
+        quint64 lastUse; // 全局访问序号，用于在分片之间比较冷热
+        RasterNode* prev;
+        RasterNode* next;
+
+        RasterNode() : lastUse(0), prev(nullptr), next(nullptr) {}
+    };
+
+    // 光栅缓存分片，各自持有锁、LRU链表和统计
+    struct RasterShard {
+        QMutex mutex;
+        QWaitCondition rasterized;            // 正在光栅化的键完成时唤醒等待的线程
+        QHash<RasterKey, RasterNode*> cache;
+        QSet<RasterKey> pending;              // 正在光栅化的键
+        RasterNode* lruHead;
+        RasterNode* lruTail;
+        quint64 hits;
+        quint64 misses;
+        quint64 evictions;
+        quint64 waits;
+
+        RasterShard()
+            : lruHead(nullptr), lruTail(nullptr)
+            , hits(0), misses(0), evictions(0), waits(0) {}
+    };
+
+    // 后台光栅化任务
+    struct AsyncJob {
+        RasterKey key;
+        QString filePath;
+        QSize size;
+        qreal devicePixelRatio;
+    };
+
+    RasterShard& shardFor(const RasterKey& key) const;
+    QImage rasterize(const QString& filePath, const QSize& size, qreal devicePixelRatio, bool colorize) const;
+    QString iconFilePath(const QString& name) const;
+    QPixmap placeholderIcon(const RasterKey& key, const QSize& size, const QColor& color, qreal devicePixelRatio) const;
+    void queueAsyncRaster(const QString& filePath, const RasterKey& key, const QSize& size, qreal devicePixelRatio) const;
+    void startAsyncJobs() const;
+    void finishAsyncJob(const AsyncJob& job, const QImage& image);
+
+    // 以下方法调用方需持有 shard.mutex
+    RasterNode* touchRasterNode(RasterShard& shard, const RasterKey& key) const;
+    RasterNode* insertRasterNode(RasterShard& shard, const RasterKey& key, const QImage& image, const QSize& size) const;
+    void removeRasterNode(RasterShard& shard, RasterNode* node) const;
+    void linkRasterNode(RasterShard& shard, RasterNode* node) const;
+    void unlinkRasterNode(RasterShard& shard, RasterNode* node) const;
+    void clearRasterCache(RasterShard& shard) const;
+    // 以下方法调用方不能持有任何分片锁
+    // 按全局数量和字节预算从最冷的分片淘汰，keep 指向的键（刚插入的项）不会被淘汰
+    void cleanupCache(const RasterKey* keep = nullptr) const;
+    void clearRasterCache() const; // 依次锁定所有分片
+    RasterKey getCacheKey(const QString& filePath, const QSize& size, bool colorize, qreal devicePixelRatio) const;
+    QSvgRenderer* getDocument(const QString& filePath) const; // 调用方需持有 m_documentMutex
+    QWinUIIconVector* extractVector(const QString& filePath) const; // 调用方需持有 m_documentMutex 和 m_packLock 读锁
+    
+    // 图标包访问（索引为条目表下标，-1 表示不存在），调用方需持有 m_packLock 读锁
+    int packIconCount() const;
+    int findPackIcon(const QString& name) const;
+    int packIndexForPath(const QString& filePath) const;
+    QString packIconName(int index) const;
+    QString packIconCategory(int index) const;
+    QRectF packIconViewBox(int index) const;
+    QPainterPath packIconPath(int index) const;
+    QImage packIconRaster(int index, int pixelSize) const;
+    QImage renderPackIcon(int index, const QSize& size, qreal devicePixelRatio) const;
+    bool isPackBacked(const QImage& image) const; // 图像数据是否直接引用图标包的映射内存
+    QByteArray packIconSvgData(int index) const;
     
-    static QWinUIIconManager* s_instance;
+    // 图标索引（图标ID为 names 中的下标）
+    struct IconIndex {
+        QStringList names;                      // 所有图标名称，已排序
+        QStringList lowerNames;                 // 小写名称，用于子串查询
+        QList<QPair<QString, int>> prefixKeys;  // 小写的完整名称和基础名称，按字符串排序
+        QHash<QString, QList<int>> categories;
+        QHash<QString, QList<int>> tags;        // 小写标签倒排索引
+        QStringList categoryNames;              // 已排序
+    };
+    const IconIndex& iconIndex() const; // 调用方需持有 m_indexMutex
+    void invalidateIconIndex();
+    QStringList iconNamesForIds(const QList<int>& ids, int limit = -1) const;
+    
+    static QAtomicPointer<QWinUIIconManager> s_instance;
     static QMutex s_mutex;
     
+    // 已注册的图标：只在管理器所在线程修改，工作线程通过 getIcon 等接口并发查询
     QHash<QString, QWinUIIconInfo> m_icons;
-    mutable QHash<QString, QWinUIIconCacheItem*> m_cache;
-    mutable QMutex m_cacheMutex;
-    int m_cacheLimit;
+    mutable QReadWriteLock m_registryLock;
+    
+    // SVG文档层：QSvgRenderer 不能并发绘制，解析和绘制都在 m_documentMutex 下进行
+    mutable QCache<QString, QSvgRenderer> m_documents; // 按文件路径缓存解析后的SVG
+    mutable QCache<QString, QWinUIIconVector> m_vectors; // 按文件路径缓存提取的矢量路径
+    mutable QMutex m_documentMutex;
+    mutable quint64 m_documentHits;
+    mutable quint64 m_documentMisses;
+    
+    // 字形轮廓层：空路径同样缓存，避免反复查询缺失的字体
+    mutable QCache<GlyphKey, QPainterPath> m_glyphPaths;
+    mutable QMutex m_glyphMutex;
+    
+    // 光栅层：数量上限和字节预算由所有分片共用，按全局计数判断是否超出
+    static constexpr int RASTER_SHARD_COUNT = 16;
+    mutable RasterShard m_shards[RASTER_SHARD_COUNT];
+    std::atomic<int> m_cacheLimit;
+    std::atomic<qint64> m_cacheByteLimit;
+    mutable std::atomic<int> m_rasterCount;
+    mutable std::atomic<qint64> m_rasterBytes;
+    mutable std::atomic<quint64> m_rasterClock; // 每次插入或命中递增
     
-    // 默认图标目录和资源路径
+    // 后台光栅化：队列中和正在运行的键不会重复提交
+    mutable QThreadPool m_asyncPool;
+    mutable QMutex m_asyncMutex;
+    mutable QList<AsyncJob> m_asyncQueue;
+    mutable QSet<RasterKey> m_asyncKeys;
+    mutable int m_asyncRunning;
+    int m_maxAsyncJobs;
+    
+    mutable IconIndex m_index;
+    mutable bool m_indexValid;
+    mutable QMutex m_indexMutex;
+    
+    // 内存映射的图标包，加载后只读；绘制期间持有读锁，加载和卸载时持有写锁
+    mutable QReadWriteLock m_packLock;
+    QFile m_packFile;
+    const uchar* m_packData;
+    qint64 m_packSize;
+    
+    // 默认图标目录、图标包和资源路径
     static const QString DEFAULT_ICON_DIRECTORY;
+    static const QString DEFAULT_ICON_PACK;
     static const QString RESOURCE_ICON_PREFIX;
+    
+    static constexpr qint64 DEFAULT_CACHE_BYTE_LIMIT = 8 * 1024 * 1024;
+    static constexpr quint32 MANIFEST_MAGIC = 0x4D495751; // "QWIM"
+    static constexpr quint32 MANIFEST_VERSION = 1;
 };
 
 QT_END_NAMESPACE
@@ -6,8 +6,14 @@
 #include <QColor>
 #include <QFont>
 #include <QMap>
-#include <QSettings>
+#include <QStringList>
+#include <QSet>
 #include <QPoint>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <initializer_list>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -20,6 +26,7 @@ class QWINUI_EXPORT QWinUITheme : public QObject
     Q_PROPERTY(QWinUIThemeMode themeMode READ themeMode WRITE setThemeMode NOTIFY themeModeChanged)
     Q_PROPERTY(QColor accentColor READ accentColor WRITE setAccentColor NOTIFY accentColorChanged)
     Q_PROPERTY(bool followSystemTheme READ followSystemTheme WRITE setFollowSystemTheme NOTIFY followSystemThemeChanged)
+    Q_PROPERTY(bool highContrast READ isHighContrast WRITE setHighContrast NOTIFY highContrastChanged)
 
 public:
     // 单例模式
@@ -41,6 +48,10 @@ public:
     // 当前是否为深色模式
     bool isDarkMode() const;
 
+    // 高对比度模式（优先于浅色/深色主题）
+    bool isHighContrast() const;
+    void setHighContrast(bool enabled);
+
     // 主题切换动画控制
     bool isThemeTransitionEnabled() const;
     void setThemeTransitionEnabled(bool enabled);
@@ -51,10 +62,126 @@ public:
     // 带动画的主题切换
     void setThemeModeWithTransition(QWinUIThemeMode mode, const QPoint& rippleCenter = QPoint());
 
-    // 颜色获取
+    // 颜色令牌：编译期编号，与 Colors 中的名称一一对应
+    // 令牌直接作为颜色表下标使用，绘制路径中无需字符串比较
+    enum class ColorToken : int {
+        // 系统强调色
+        SystemAccentColor,
+        SystemAccentColorLight1,
+        SystemAccentColorLight2,
+        SystemAccentColorLight3,
+        SystemAccentColorDark1,
+        SystemAccentColorDark2,
+        SystemAccentColorDark3,
+
+        // 控件填充色
+        ControlFillColorDefault,
+        ControlFillColorSecondary,
+        ControlFillColorTertiary,
+        ControlFillColorDisabled,
+        ControlFillColorTransparent,
+        ControlFillColorInputActive,
+
+        // 控件边框色
+        ControlStrokeColorDefault,
+        ControlStrokeColorSecondary,
+        ControlStrokeColorOnAccentDefault,
+        ControlStrokeColorOnAccentSecondary,
+        ControlStrokeColorOnAccentTertiary,
+        ControlStrokeColorOnAccentDisabled,
+        ControlStrokeColorForStrongFillWhenOnImage,
+        ControlStrokeColorDisabled,
+
+        // 文本颜色
+        TextFillColorPrimary,
+        TextFillColorSecondary,
+        TextFillColorTertiary,
+        TextFillColorDisabled,
+        TextFillColorInverse,
+
+        // 背景色
+        ApplicationPageBackgroundThemeBrush,
+        LayerFillColorDefault,
+        LayerFillColorAlt,
+        LayerOnAcrylicFillColorDefault,
+        LayerOnAccentAcrylicFillColorDefault,
+
+        // 中性色
+        NeutralPrimary,
+        NeutralSecondary,
+        NeutralTertiary,
+        NeutralQuaternary,
+        NeutralLight,
+        NeutralLighter,
+        NeutralLightest,
+
+        // 语义色
+        SystemFillColorSuccess,
+        SystemFillColorCaution,
+        SystemFillColorCritical,
+        SystemFillColorNeutral,
+        SystemFillColorSolidNeutral,
+        SystemFillColorAttentionBackground,
+        SystemFillColorSuccessBackground,
+        SystemFillColorCautionBackground,
+        SystemFillColorCriticalBackground,
+
+        Count
+    };
+    static constexpr int ColorTokenCount = static_cast<int>(ColorToken::Count);
+    using ColorTable = std::array<QColor, ColorTokenCount>;
+    using ColorTokenSet = std::bitset<ColorTokenCount>;
+
+    // 不可变调色板快照
+    // 每次主题或颜色变化都会构建新的快照并整体替换，旧快照在最后一个持有者释放后销毁。
+    // 快照内容创建后不再修改，可在任意线程读取而无需加锁。
+    class QWINUI_EXPORT Palette
+    {
+    public:
+        Palette(const ColorTable& colors, quint64 generation, bool isDark, bool isHighContrast);
+
+        QColor color(ColorToken token) const { return m_colors[static_cast<int>(token)]; }
+        const ColorTable& colors() const { return m_colors; }
+        quint64 generation() const { return m_generation; }
+        bool isDarkMode() const { return m_isDark; }
+        bool isHighContrast() const { return m_isHighContrast; }
+
+    private:
+        const ColorTable m_colors;
+        const quint64 m_generation;
+        const bool m_isDark;
+        const bool m_isHighContrast;
+    };
+    using PalettePtr = std::shared_ptr<const Palette>;
+
+    // 获取当前调色板快照（线程安全，离屏渲染线程应使用该接口）
+    PalettePtr palette() const;
+
+    // 调色板代数，每次发布新快照时递增；控件可按代数缓存解析后的颜色
+    quint64 paletteGeneration() const;
+
+    // 颜色获取（按令牌，推荐在绘制路径中使用；仅限 GUI 线程）
+    QColor getColor(ColorToken token) const;
+    void setColor(ColorToken token, const QColor& color);
+
+    // 颜色获取（按名称，内部映射到令牌；未知名称作为自定义颜色保存）
     QColor getColor(const QString& colorName) const;
     void setColor(const QString& colorName, const QColor& color);
 
+    // 批量修改：beginUpdate()/endUpdate() 之间的颜色修改暂存起来，
+    // 最外层 endUpdate() 时只发布一次快照并发出一次 themeChanged，可嵌套调用
+    void beginUpdate();
+    void endUpdate();
+    bool isUpdating() const;
+
+    // 令牌与名称互相转换
+    static QString colorTokenName(ColorToken token);
+    static bool colorTokenFromName(const QString& colorName, ColorToken* token);
+
+    // 令牌集合：由令牌列表构造；强调色及其全部变体
+    static ColorTokenSet colorTokenSet(std::initializer_list<ColorToken> tokens);
+    static ColorTokenSet accentColorTokens();
+
     // 字体获取
     QFont getFont(const QString& fontName) const;
     void setFont(const QString& fontName, const QFont& font);
@@ -150,8 +277,11 @@ public:
     };
 
     // 主题保存和加载
-    void saveTheme(const QString& filePath = QString()) const;
-    void loadTheme(const QString& filePath = QString());
+    // 使用带版本号的二进制格式（主题模式、用户指定的强调色和颜色、自定义颜色、字体、间距），
+    // 由主题推导的颜色不保存；加载时一次映射整个文件后解析，路径为空时使用应用配置目录下的默认文件
+    bool saveTheme(const QString& filePath = QString()) const;
+    bool loadTheme(const QString& filePath = QString());
+    static QString defaultThemeFilePath();
 
     // 重置为默认主题
     void resetToDefault();
@@ -160,18 +290,20 @@ public:
     QColor getSystemAccentColor() const;
 
     // 便利方法 - 直接获取常用颜色
-    QColor controlFillColorDefault() const { return getColor(Colors::ControlFillColorDefault); }
-    QColor controlFillColorDisabled() const { return getColor(Colors::ControlFillColorDisabled); }
-    QColor controlStrokeColorDefault() const { return getColor(Colors::ControlStrokeColorDefault); }
-    QColor controlStrokeColorDisabled() const { return getColor(Colors::ControlStrokeColorDisabled); }
-    QColor textFillColorPrimary() const { return getColor(Colors::TextFillColorPrimary); }
-    QColor textFillColorDisabled() const { return getColor(Colors::TextFillColorDisabled); }
+    QColor controlFillColorDefault() const { return getColor(ColorToken::ControlFillColorDefault); }
+    QColor controlFillColorDisabled() const { return getColor(ColorToken::ControlFillColorDisabled); }
+    QColor controlStrokeColorDefault() const { return getColor(ColorToken::ControlStrokeColorDefault); }
+    QColor controlStrokeColorDisabled() const { return getColor(ColorToken::ControlStrokeColorDisabled); }
+    QColor textFillColorPrimary() const { return getColor(ColorToken::TextFillColorPrimary); }
+    QColor textFillColorDisabled() const { return getColor(ColorToken::TextFillColorDisabled); }
 
 signals:
     void themeModeChanged(QWinUIThemeMode mode);
     void accentColorChanged(const QColor& color);
     void followSystemThemeChanged(bool follow);
-    void themeChanged();
+    void highContrastChanged(bool enabled);
+    // changedTokens 为本次变化涉及的颜色令牌；整体切换主题或修改自定义颜色时全部置位
+    void themeChanged(const QWinUITheme::ColorTokenSet& changedTokens);
     void colorChanged(const QString& colorName, const QColor& color);
 
 private slots:
@@ -182,10 +314,22 @@ private:
     ~QWinUITheme();
 
     void initializeTheme();
-    void loadLightTheme();
-    void loadDarkTheme();
-    void loadHighContrastTheme();
-    void updateAccentColorVariants();
+    static const ColorTable& loadLightTheme();
+    static const ColorTable& loadDarkTheme();
+    static const ColorTable& loadHighContrastTheme();
+    void applyAccentColorVariants(ColorTable& colors) const;
+    void rebuildPalette();
+    void publishPalette(const ColorTable& colors);
+    const ColorTable& currentColors() const;
+    void commitColors(const ColorTable& colors, const ColorTokenSet& changedTokens);
+    void notifyThemeChanged(const ColorTokenSet& changedTokens);
+
+    // 可见控件登记表（由 QWinUIWidget 在显示/隐藏时维护）
+    friend class QWinUIWidget;
+    void registerVisibleWidget(QWinUIWidget* widget);
+    void unregisterVisibleWidget(QWinUIWidget* widget);
+    quint64 themeChangeSerial() const;
+    bool getSystemHighContrast() const;
     void connectToSystemTheme();
     void disconnectFromSystemTheme();
 
@@ -200,15 +344,35 @@ private:
 
     QWinUIThemeMode m_themeMode;
     QColor m_accentColor;
+    bool m_accentOverridden; // 强调色由 setAccentColor 指定，而不是取自系统
     bool m_followSystemTheme;
     bool m_isDarkMode;
-
-    QMap<QString, QColor> m_colors;
+    bool m_isHighContrast;
+
+    // 当前调色板快照，只在 GUI 线程替换（通过 std::atomic_store），
+    // 其他线程通过 std::atomic_load 读取
+    PalettePtr m_palette;
+    std::atomic<quint64> m_paletteGeneration;
+
+    // 非预定义名称的颜色单独保存（仅限 GUI 线程）
+    QMap<QString, QColor> m_customColors;
+    // 通过 setColor 修改过的令牌，重建调色板时清空；保存主题时只保存这些颜色
+    ColorTokenSet m_overriddenTokens;
+
+    // 批量修改状态
+    int m_updateDepth;
+    bool m_hasStagedColors;
+    ColorTable m_stagedColors;
+    ColorTokenSet m_pendingTokens;       // 待发出 themeChanged 的令牌
+    ColorTokenSet m_pendingColorSignals; // 通过 setColor 修改、待发出 colorChanged 的令牌
+    QStringList m_pendingCustomColors;
+
+    // 主题变化只直接刷新可见控件，隐藏控件在下次显示时按序号判断是否需要刷新
+    QSet<QWinUIWidget*> m_visibleWidgets;
+    quint64 m_themeChangeSerial;
     QMap<QString, QFont> m_fonts;
     QMap<QString, int> m_spacing;
 
-    QSettings* m_settings;
-
     // 主题切换动画控制
     bool m_themeTransitionEnabled;
     int m_themeTransitionMode;
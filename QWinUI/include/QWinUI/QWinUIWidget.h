@@ -2,6 +2,7 @@
 #define QWINUIWIDGET_H
 
 #include "QWinUIGlobal.h"
+#include "QWinUITheme.h"
 #include <QWidget>
 #include <QColor>
 #include <QPainter>
@@ -13,7 +14,6 @@
 
 QT_BEGIN_NAMESPACE
 
-class QWinUITheme;
 class QWinUIAnimation;
 class QWinUIBlurEffect;
 class QWinUIToolTip;
@@ -119,6 +119,8 @@ protected:
     void focusInEvent(QFocusEvent* event) override;
     void focusOutEvent(QFocusEvent* event) override;
     void changeEvent(QEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
 
     // 绘制相关的虚函数
     virtual void drawBackground(QPainter* painter, const QRect& rect);
@@ -142,12 +144,22 @@ protected:
     virtual void updateControlState();
     virtual void onThemeChanged();
 
+    // 控件绘制所依赖的主题颜色令牌；主题变化不涉及这些令牌时跳过刷新
+    // 默认依赖全部令牌，只读取少数令牌的子类可重写以减少无效重绘
+    virtual QWinUITheme::ColorTokenSet themeColorTokens() const;
+
 private slots:
-    void onThemeChangedInternal();
     void onAnimationFinished();
 
 private:
+    // 由 QWinUITheme 的可见控件登记表调用
+    friend class QWinUITheme;
+    void onThemeChangedInternal(const QWinUITheme::ColorTokenSet& changedTokens);
+    void registerWithTheme();
+    void unregisterFromTheme();
+
     void initializeWidget();
+    QWinUIAnimation* ensureAnimation();
     void setupShadowEffect();
     void updateShadowEffect();
 
@@ -156,19 +168,10 @@ private:
     QColor getThemeTextColor() const;
     QColor getThemeBorderColor() const;
 
-    // 主题切换动画相关
-    void updateThemeTransition();
-    void drawThemeTransition(QPainter* painter);
-    void drawRippleTransition(QPainter* painter, const QColor& oldColor, const QColor& newColor);
-    void drawFadeTransition(QPainter* painter, const QColor& oldColor, const QColor& newColor);
-    bool isCircleTouchingWidget(const QPoint& center, double radius) const;
-    double getDistanceToWidget(const QPoint& center) const;
-    double getDistanceToWidgetGlobal(const QPoint& center, const QRect& widgetRect) const;
-    QColor getTransitionBackgroundColor(const QPoint& pos) const;
-    double getDistanceFromTransitionCenter(const QPoint& pos) const;
-
 private:
     QWinUITheme* m_theme;
+    bool m_themeRegistered;
+    quint64 m_themeSerial; // 最近一次应用的主题变化序号
     QWinUIAnimation* m_animation;
     
     int m_cornerRadius;
@@ -178,33 +181,11 @@ private:
     QWinUIShadowDepth m_shadowDepth;
     
     QGraphicsDropShadowEffect* m_shadowEffect;
-    QPropertyAnimation* m_stateAnimation;
 
     bool m_isHovered;
     bool m_isPressed;
     QPoint m_lastMousePos;
 
-    // 主题切换动画相关
-    bool m_isThemeTransitioning;
-    QWinUITransitionMode m_transitionMode;
-    QPoint m_transitionCenter;
-    double m_transitionRadius;
-    double m_maxTransitionRadius;
-    QTimer* m_transitionTimer;
-    QWinUIThemeMode m_oldThemeMode;
-    QWinUIThemeMode m_newThemeMode;
-    bool m_hasBeenTouched; // 标记此控件是否已被圆圈接触过
-
-    // 颜色过渡动画相关
-    double m_fadeProgress; // 0.0 到 1.0 的过渡进度
-    QColor m_oldBackgroundColor;
-    QColor m_newBackgroundColor;
-
-    // 性能优化缓存
-    mutable QPainterPath m_cachedClipPath; // 缓存裁剪路径
-    mutable bool m_clipPathValid; // 裁剪路径是否有效
-    mutable QRect m_lastRect; // 上次的矩形，用于检测尺寸变化
-
     // ToolTip 相关
     QWinUIToolTip* m_toolTip;
     QString m_toolTipText;
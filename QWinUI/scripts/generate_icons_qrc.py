@@ -1,11 +1,20 @@
 #!/usr/bin/env python3
 """
-自动生成SVG图标的QRC资源文件
-遍历Icon目录下的所有SVG文件并生成对应的QRC文件
+自动生成SVG图标资源
+遍历Icon目录下的所有SVG文件，生成图标包（--pack）或对应的QRC文件
+
+图标包是一个带索引的二进制文件，QWinUIIconManager 以内存映射方式加载：
+按名称哈希 O(1) 查找，路径数据已预先解析为绝对坐标的 移动/直线/三次曲线/闭合 指令，
+启动时不解析任何SVG。可选地为常用尺寸预先光栅化8位alpha遮罩。
 """
 
+import argparse
+import math
 import os
+import re
+import struct
 import sys
+import xml.etree.ElementTree as ET
 from pathlib import Path
 
 def generate_qrc_file(icon_dir, output_file):
@@ -142,15 +151,537 @@ def generate_icon_constants(svg_files, output_file):
         print(f"错误: 无法写入头文件 {output_file}: {e}")
         return False
 
+# ---------------------------------------------------------------------------
+# 图标包
+#
+# 文件布局（小端序，各区段4字节对齐）：
+#   头部       PACK_HEADER
+#   哈希桶     u32[bucketCount]，值为 条目索引 + 1，0 表示空桶（线性探测）
+#   条目表     PACK_ENTRY[iconCount]
+#   字符串区   UTF-8 图标名称和分类
+#   指令区     u8 指令流
+#   坐标区     float32 坐标流
+#   光栅区     每个图标按 rasterSizes 顺序存放 size 行alpha遮罩，每行4字节对齐
+# ---------------------------------------------------------------------------
+
+PACK_MAGIC = 0x50495751  # 'QWIP'
+PACK_VERSION = 1
+PACK_MAX_RASTER_SIZES = 8
+
+# magic, version, rasterSizeCount, iconCount, bucketCount, bucketsOffset,
+# entriesOffset, stringsOffset, commandsOffset, coordsOffset, rastersOffset,
+# fileSize, rasterSizes[8]
+PACK_HEADER = struct.Struct('<IHHIIIIIIIII8H')
+
+# nameOffset, nameLength, categoryLength, categoryOffset, viewBox[4],
+# commandOffset, commandCount, coordOffset, coordCount, rasterOffset, reserved
+PACK_ENTRY = struct.Struct('<IHHI4fIIIIII')
+
+CMD_MOVE = 0
+CMD_LINE = 1
+CMD_CUBIC = 2
+CMD_CLOSE = 3
+
+CMD_COORD_COUNT = {CMD_MOVE: 2, CMD_LINE: 2, CMD_CUBIC: 6, CMD_CLOSE: 0}
+
+_NUMBER_RE = re.compile(r'[-+]?(?:\d+\.?\d*|\.\d+)(?:[eE][-+]?\d+)?')
+_PATH_COMMANDS = 'MmLlHhVvCcSsQqTtAaZz'
+
+
+def fnv1a32(data):
+    """FNV-1a 32位哈希，与 QWinUIIconManager 中的实现保持一致"""
+    h = 0x811C9DC5
+    for byte in data:
+        h ^= byte
+        h = (h * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+class _PathReader:
+    """SVG路径数据读取器（弧线标志位可以不带分隔符，不能直接用正则切分）"""
+
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def _skip(self):
+        while self.pos < len(self.data) and self.data[self.pos] in ' \t\r\n,':
+            self.pos += 1
+
+    def at_end(self):
+        self._skip()
+        return self.pos >= len(self.data)
+
+    def has_command(self):
+        self._skip()
+        return self.pos < len(self.data) and self.data[self.pos] in _PATH_COMMANDS
+
+    def command(self):
+        self._skip()
+        ch = self.data[self.pos]
+        self.pos += 1
+        return ch
+
+    def number(self):
+        self._skip()
+        match = _NUMBER_RE.match(self.data, self.pos)
+        if not match:
+            raise ValueError(f"路径数据第 {self.pos} 个字符处需要数字")
+        self.pos = match.end()
+        return float(match.group(0))
+
+    def flag(self):
+        self._skip()
+        if self.pos >= len(self.data) or self.data[self.pos] not in '01':
+            raise ValueError(f"路径数据第 {self.pos} 个字符处需要弧线标志")
+        self.pos += 1
+        return self.data[self.pos - 1] == '1'
+
+
+def _arc_to_cubics(x1, y1, rx, ry, angle, large_arc, sweep, x2, y2):
+    """按SVG规范附录 F.6 把椭圆弧转换为三次曲线"""
+    if x1 == x2 and y1 == y2:
+        return []
+
+    rx, ry = abs(rx), abs(ry)
+    if rx == 0 or ry == 0:
+        return [(CMD_LINE, (x2, y2))]
+
+    phi = math.radians(angle)
+    cos_phi, sin_phi = math.cos(phi), math.sin(phi)
+
+    dx2, dy2 = (x1 - x2) / 2.0, (y1 - y2) / 2.0
+    x1p = cos_phi * dx2 + sin_phi * dy2
+    y1p = -sin_phi * dx2 + cos_phi * dy2
+
+    # 半径不足以连接两个端点时按比例放大
+    scale = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry)
+    if scale > 1.0:
+        scale = math.sqrt(scale)
+        rx *= scale
+        ry *= scale
+
+    num = rx * rx * ry * ry - rx * rx * y1p * y1p - ry * ry * x1p * x1p
+    den = rx * rx * y1p * y1p + ry * ry * x1p * x1p
+    coef = math.sqrt(max(0.0, num / den)) if den else 0.0
+    if large_arc == sweep:
+        coef = -coef
+
+    cxp = coef * rx * y1p / ry
+    cyp = -coef * ry * x1p / rx
+    cx = cos_phi * cxp - sin_phi * cyp + (x1 + x2) / 2.0
+    cy = sin_phi * cxp + cos_phi * cyp + (y1 + y2) / 2.0
+
+    theta1 = math.atan2((y1p - cyp) / ry, (x1p - cxp) / rx)
+    theta2 = math.atan2((-y1p - cyp) / ry, (-x1p - cxp) / rx)
+    delta = theta2 - theta1
+    if sweep and delta < 0:
+        delta += 2 * math.pi
+    elif not sweep and delta > 0:
+        delta -= 2 * math.pi
+
+    def point(ux, uy):
+        return (cx + rx * ux * cos_phi - ry * uy * sin_phi,
+                cy + rx * ux * sin_phi + ry * uy * cos_phi)
+
+    # 每段不超过90度
+    segments = max(1, int(math.ceil(abs(delta) / (math.pi / 2) - 1e-9)))
+    step = delta / segments
+    t = 4.0 / 3.0 * math.tan(step / 4.0)
+
+    result = []
+    for i in range(segments):
+        a1 = theta1 + i * step
+        a2 = a1 + step
+        c1, s1 = math.cos(a1), math.sin(a1)
+        c2, s2 = math.cos(a2), math.sin(a2)
+        p1 = point(c1 - t * s1, s1 + t * c1)
+        p2 = point(c2 + t * s2, s2 - t * c2)
+        p3 = (x2, y2) if i == segments - 1 else point(c2, s2)
+        result.append((CMD_CUBIC, p1 + p2 + p3))
+    return result
+
+
+def parse_svg_path(data):
+    """
+    解析SVG路径数据
+
+    Returns:
+        [(指令, 坐标元组)]，坐标均为绝对坐标；H/V 转为直线，二次曲线和弧线转为三次曲线
+    """
+    reader = _PathReader(data)
+    result = []
+    cur_x = cur_y = 0.0
+    start_x = start_y = 0.0
+    cubic_ctrl = None  # 上一条 C/S 的第二控制点，用于 S 的反射
+    quad_ctrl = None   # 上一条 Q/T 的控制点，用于 T 的反射
+    command = None
+
+    while not reader.at_end():
+        if reader.has_command():
+            command = reader.command()
+        elif command is None or command in 'Zz':
+            raise ValueError("路径数据缺少指令")
+
+        relative = command.islower()
+        kind = command.upper()
+        base_x, base_y = (cur_x, cur_y) if relative else (0.0, 0.0)
+        next_cubic_ctrl = None
+        next_quad_ctrl = None
+
+        if kind == 'M':
+            cur_x, cur_y = reader.number() + base_x, reader.number() + base_y
+            start_x, start_y = cur_x, cur_y
+            result.append((CMD_MOVE, (cur_x, cur_y)))
+            # 移动指令后的连续坐标按直线处理
+            command = 'l' if relative else 'L'
+        elif kind == 'Z':
+            result.append((CMD_CLOSE, ()))
+            cur_x, cur_y = start_x, start_y
+        elif kind == 'L':
+            cur_x, cur_y = reader.number() + base_x, reader.number() + base_y
+            result.append((CMD_LINE, (cur_x, cur_y)))
+        elif kind == 'H':
+            cur_x = reader.number() + base_x
+            result.append((CMD_LINE, (cur_x, cur_y)))
+        elif kind == 'V':
+            cur_y = reader.number() + base_y
+            result.append((CMD_LINE, (cur_x, cur_y)))
+        elif kind in 'CS':
+            if kind == 'C':
+                x1, y1 = reader.number() + base_x, reader.number() + base_y
+            elif cubic_ctrl:
+                x1, y1 = 2 * cur_x - cubic_ctrl[0], 2 * cur_y - cubic_ctrl[1]
+            else:
+                x1, y1 = cur_x, cur_y
+            x2, y2 = reader.number() + base_x, reader.number() + base_y
+            cur_x, cur_y = reader.number() + base_x, reader.number() + base_y
+            result.append((CMD_CUBIC, (x1, y1, x2, y2, cur_x, cur_y)))
+            next_cubic_ctrl = (x2, y2)
+        elif kind in 'QT':
+            if kind == 'Q':
+                qx, qy = reader.number() + base_x, reader.number() + base_y
+            elif quad_ctrl:
+                qx, qy = 2 * cur_x - quad_ctrl[0], 2 * cur_y - quad_ctrl[1]
+            else:
+                qx, qy = cur_x, cur_y
+            x, y = reader.number() + base_x, reader.number() + base_y
+            result.append((CMD_CUBIC, (cur_x + 2.0 / 3.0 * (qx - cur_x), cur_y + 2.0 / 3.0 * (qy - cur_y),
+                                       x + 2.0 / 3.0 * (qx - x), y + 2.0 / 3.0 * (qy - y), x, y)))
+            cur_x, cur_y = x, y
+            next_quad_ctrl = (qx, qy)
+        elif kind == 'A':
+            rx, ry, angle = reader.number(), reader.number(), reader.number()
+            large_arc, sweep = reader.flag(), reader.flag()
+            x, y = reader.number() + base_x, reader.number() + base_y
+            result.extend(_arc_to_cubics(cur_x, cur_y, rx, ry, angle, large_arc, sweep, x, y))
+            cur_x, cur_y = x, y
+
+        cubic_ctrl = next_cubic_ctrl
+        quad_ctrl = next_quad_ctrl
+
+    return result
+
+
+def _local_tag(element):
+    return element.tag.rsplit('}', 1)[-1]
+
+
+def parse_svg_icon(svg_path):
+    """
+    读取单个SVG图标
+
+    只支持由无变换的 <path> 组成的单色图标（Font Awesome 等图标集均满足），
+    填充规则为SVG默认的非零环绕。
+
+    Returns:
+        (viewBox, 路径指令列表)
+    """
+    root = ET.parse(svg_path).getroot()
+    if _local_tag(root) != 'svg':
+        raise ValueError("根元素不是 <svg>")
+
+    view_box = root.get('viewBox')
+    if view_box:
+        values = [float(v) for v in re.split(r'[\s,]+', view_box.strip())]
+        if len(values) != 4:
+            raise ValueError(f"无效的 viewBox: {view_box}")
+    else:
+        values = [0.0, 0.0,
+                  float(re.sub(r'[a-z]+$', '', root.get('width', '24'))),
+                  float(re.sub(r'[a-z]+$', '', root.get('height', '24')))]
+    if values[2] <= 0 or values[3] <= 0:
+        raise ValueError("viewBox 尺寸无效")
+
+    commands = []
+    for element in root.iter():
+        tag = _local_tag(element)
+        if element.get('transform'):
+            raise ValueError(f"不支持带 transform 的 <{tag}>")
+        if tag == 'path':
+            commands.extend(parse_svg_path(element.get('d', '')))
+        elif tag not in ('svg', 'g', 'title', 'desc'):
+            raise ValueError(f"不支持的元素 <{tag}>")
+
+    if not commands:
+        raise ValueError("没有路径数据")
+    return tuple(values), commands
+
+
+def _flatten_path(commands, view_box, size):
+    """把路径按 viewBox 拉伸到 size×size 像素（与 QSvgRenderer 默认行为一致）并展开为线段"""
+    vx, vy, vw, vh = view_box
+    sx, sy = size / vw, size / vh
+
+    def tx(x, y):
+        return ((x - vx) * sx, (y - vy) * sy)
+
+    edges = []
+    start = cur = None
+    for cmd, coords in commands:
+        if cmd == CMD_MOVE:
+            if cur and start and cur != start:
+                edges.append(cur + start)
+            start = cur = tx(*coords)
+        elif cmd == CMD_LINE:
+            point = tx(*coords)
+            edges.append(cur + point)
+            cur = point
+        elif cmd == CMD_CUBIC:
+            p1, p2, p3 = tx(*coords[0:2]), tx(*coords[2:4]), tx(*coords[4:6])
+            length = math.dist(cur, p1) + math.dist(p1, p2) + math.dist(p2, p3)
+            steps = max(2, min(64, int(math.ceil(length / 1.5))))
+            prev = cur
+            for i in range(1, steps + 1):
+                t = i / steps
+                mt = 1.0 - t
+                a, b, c, d = mt * mt * mt, 3 * mt * mt * t, 3 * mt * t * t, t * t * t
+                point = (a * cur[0] + b * p1[0] + c * p2[0] + d * p3[0],
+                         a * cur[1] + b * p1[1] + c * p2[1] + d * p3[1])
+                edges.append(prev + point)
+                prev = point
+            cur = p3
+        elif cmd == CMD_CLOSE:
+            if cur and start and cur != start:
+                edges.append(cur + start)
+            cur = start
+    # 填充时未闭合的子路径视为闭合
+    if cur and start and cur != start:
+        edges.append(cur + start)
+    return edges
+
+
+def rasterize_alpha(commands, view_box, size, subsamples=16):
+    """
+    按非零环绕规则把路径光栅化为 size×size 的8位alpha遮罩
+
+    垂直方向每像素采样 subsamples 条扫描线，水平方向按跨度精确计算覆盖率。
+    """
+    edges = []
+    for x0, y0, x1, y1 in _flatten_path(commands, view_box, size):
+        if y0 == y1:
+            continue
+        direction = 1 if y1 > y0 else -1
+        if y0 > y1:
+            x0, y0, x1, y1 = x1, y1, x0, y0
+        edges.append((y0, y1, x0, (x1 - x0) / (y1 - y0), direction))
+    edges.sort()
+
+    coverage = [0.0] * (size * size)
+    weight = 1.0 / subsamples
+    active = []
+    next_edge = 0
+
+    for sub in range(size * subsamples):
+        y = (sub + 0.5) / subsamples
+        while next_edge < len(edges) and edges[next_edge][0] <= y:
+            active.append(edges[next_edge])
+            next_edge += 1
+        active = [e for e in active if e[1] > y]
+        if not active:
+            continue
+
+        crossings = sorted((e[2] + (y - e[0]) * e[3], e[4]) for e in active if e[0] <= y)
+        row = (sub // subsamples) * size
+        winding = 0
+        span_start = 0.0
+        for x, direction in crossings:
+            if winding == 0:
+                span_start = x
+            winding += direction
+            if winding != 0:
+                continue
+
+            xa, xb = max(0.0, span_start), min(float(size), x)
+            if xb <= xa:
+                continue
+            pa, pb = int(xa), int(xb)
+            if pa == pb:
+                coverage[row + pa] += (xb - xa) * weight
+                continue
+            coverage[row + pa] += (pa + 1 - xa) * weight
+            for px in range(pa + 1, pb):
+                coverage[row + px] += weight
+            if pb < size:
+                coverage[row + pb] += (xb - pb) * weight
+
+    return bytes(min(255, int(round(c * 255.0))) for c in coverage)
+
+
+def _align4(buffer):
+    while len(buffer) % 4:
+        buffer.append(0)
+
+
+def generate_icon_pack(icon_dir, output_file, raster_sizes=()):
+    """
+    生成内存映射图标包
+
+    Args:
+        icon_dir: 图标目录路径
+        output_file: 输出的图标包路径
+        raster_sizes: 需要预光栅化的像素尺寸（正方形），为空则只保存矢量路径
+    """
+
+    if not os.path.exists(icon_dir):
+        print(f"错误: 图标目录 {icon_dir} 不存在")
+        return False
+
+    raster_sizes = sorted(set(int(s) for s in raster_sizes))
+    if len(raster_sizes) > PACK_MAX_RASTER_SIZES or any(s <= 0 or s > 256 for s in raster_sizes):
+        print(f"错误: 预光栅化尺寸最多 {PACK_MAX_RASTER_SIZES} 个，且每个在 1 到 256 之间")
+        return False
+
+    # 图标名称与QRC别名一致：相对路径去掉 .svg，分类为所在目录名
+    icons = []
+    for svg_path in sorted(Path(icon_dir).rglob("*.svg")):
+        rel_path = svg_path.relative_to(icon_dir).as_posix()
+        name = rel_path[:-4]
+        category = svg_path.parent.name if svg_path.parent != Path(icon_dir) else "General"
+        try:
+            view_box, commands = parse_svg_icon(svg_path)
+        except (ET.ParseError, ValueError) as e:
+            print(f"警告: 跳过 {rel_path}: {e}")
+            continue
+        icons.append((name, category, view_box, commands))
+
+    print(f"打包 {len(icons)} 个图标")
+
+    strings = bytearray()
+    string_offsets = {}
+
+    def add_string(text):
+        if text not in string_offsets:
+            string_offsets[text] = len(strings)
+            strings.extend(text.encode('utf-8'))
+        return string_offsets[text]
+
+    command_data = bytearray()
+    coord_data = bytearray()
+    raster_data = bytearray()
+    entries = []
+
+    for index, (name, category, view_box, commands) in enumerate(icons):
+        name_offset = add_string(name)
+        category_offset = add_string(category)
+        command_offset = len(command_data)
+        coord_offset = len(coord_data) // 4
+        for cmd, coords in commands:
+            command_data.append(cmd)
+            coord_data.extend(struct.pack(f'<{len(coords)}f', *coords))
+        coord_count = len(coord_data) // 4 - coord_offset
+
+        raster_offset = None
+        if raster_sizes:
+            raster_offset = len(raster_data)
+            for size in raster_sizes:
+                # 每行按4字节对齐，加载时可直接作为 QImage 扫描线使用
+                mask = rasterize_alpha(commands, view_box, size)
+                padding = bytes((-size) % 4)
+                for y in range(size):
+                    raster_data.extend(mask[y * size:(y + 1) * size])
+                    raster_data.extend(padding)
+            if (index + 1) % 200 == 0:
+                print(f"已光栅化 {index + 1}/{len(icons)}")
+
+        entries.append([name_offset, len(name.encode('utf-8')), len(category.encode('utf-8')), category_offset,
+                         view_box, command_offset, len(commands), coord_offset, coord_count, raster_offset])
+
+    # 开放寻址哈希表，装载因子不超过0.5
+    bucket_count = 1
+    while bucket_count < max(2, len(icons) * 2):
+        bucket_count *= 2
+    buckets = [0] * bucket_count
+    for index, (name, _, _, _) in enumerate(icons):
+        slot = fnv1a32(name.encode('utf-8')) & (bucket_count - 1)
+        while buckets[slot]:
+            slot = (slot + 1) & (bucket_count - 1)
+        buckets[slot] = index + 1
+
+    _align4(strings)
+    _align4(command_data)
+
+    buckets_offset = PACK_HEADER.size
+    entries_offset = buckets_offset + bucket_count * 4
+    strings_offset = entries_offset + len(entries) * PACK_ENTRY.size
+    commands_offset = strings_offset + len(strings)
+    coords_offset = commands_offset + len(command_data)
+    rasters_offset = coords_offset + len(coord_data)
+    file_size = rasters_offset + len(raster_data)
+
+    sizes = raster_sizes + [0] * (PACK_MAX_RASTER_SIZES - len(raster_sizes))
+    output = bytearray(PACK_HEADER.pack(PACK_MAGIC, PACK_VERSION, len(raster_sizes), len(icons), bucket_count,
+                                        buckets_offset, entries_offset, strings_offset, commands_offset,
+                                        coords_offset, rasters_offset, file_size, *sizes))
+    output.extend(struct.pack(f'<{bucket_count}I', *buckets))
+    for (name_offset, name_length, category_length, category_offset, view_box,
+         command_offset, command_count, coord_offset, coord_count, raster_offset) in entries:
+        output.extend(PACK_ENTRY.pack(name_offset, name_length, category_length, category_offset, *view_box,
+                                      command_offset, command_count, coord_offset, coord_count,
+                                      0 if raster_offset is None else rasters_offset + raster_offset, 0))
+    output.extend(strings)
+    output.extend(command_data)
+    output.extend(coord_data)
+    output.extend(raster_data)
+    assert len(output) == file_size
+
+    try:
+        os.makedirs(os.path.dirname(os.path.abspath(output_file)), exist_ok=True)
+        with open(output_file, 'wb') as f:
+            f.write(output)
+        print(f"成功生成图标包: {output_file} ({file_size / 1024:.1f} KB)")
+        return True
+    except Exception as e:
+        print(f"错误: 无法写入图标包 {output_file}: {e}")
+        return False
+
+
 def main():
     """主函数"""
     
+    parser = argparse.ArgumentParser(description="QWinUI 图标资源生成器")
+    parser.add_argument("--pack", metavar="FILE",
+                        help="生成内存映射图标包（构建时使用），不再生成QRC和头文件")
+    parser.add_argument("--raster-sizes", default="",
+                        help="图标包中预光栅化的像素尺寸，逗号分隔，例如 16,24,32")
+    parser.add_argument("--icon-dir", help="图标目录，默认为项目根目录下的 Icon")
+    args = parser.parse_args()
+    
     # 获取脚本所在目录
     script_dir = Path(__file__).parent
     project_root = script_dir.parent
     
     # 设置路径
-    icon_dir = project_root / "Icon"
+    icon_dir = Path(args.icon_dir) if args.icon_dir else project_root / "Icon"
+    
+    if args.pack:
+        try:
+            raster_sizes = [int(s) for s in args.raster_sizes.replace(';', ',').split(',') if s.strip()]
+        except ValueError:
+            print(f"错误: 无效的预光栅化尺寸 {args.raster_sizes}")
+            return 1
+        return 0 if generate_icon_pack(str(icon_dir), args.pack, raster_sizes) else 1
+    
     qrc_file = project_root / "resources" / "icons.qrc"
     header_file = project_root / "include" / "QWinUI" / "QWinUIIconPaths.h"
     
@@ -1,17 +1,235 @@
 #include "QWinUI/Controls/QWinUIAcrylicBrush.h"
 #include "QWinUI/QWinUITheme.h"
+#include "../QWinUIImageBlur.h"
 #include <QPainter>
 #include <QPaintEvent>
-#include <QGraphicsBlurEffect>
-#include <QGraphicsPixmapItem>
-#include <QGraphicsScene>
-#include <QGraphicsView>
+#include <QPainterPath>
 #include <QApplication>
 #include <QScreen>
 #include <QWindow>
-#include <QRandomGenerator>
+#include <QCache>
+#include <QHash>
 #include <QtMath>
 #include <QDebug>
+#include <QPointer>
+#include <cstring>
+#include <limits>
+
+// 跟踪亚克力画刷下方控件的重绘（内部类）
+// 在应用程序上安装一个事件过滤器，把画刷下方控件的绘制区域映射为画刷的脏区域；
+// 画刷抓取背景时会离屏绘制这些控件，此期间产生的绘制事件不计入。
+// 画刷是半透明的，画刷或其子控件重绘时下方区域也会随之重绘，这部分不是背景变化：
+// 同时记录画刷自身的重绘区域，抓取前从脏区域中扣除
+class QWinUIAcrylicBackdropTracker : public QObject
+{
+public:
+    static QWinUIAcrylicBackdropTracker* getInstance()
+    {
+        static QPointer<QWinUIAcrylicBackdropTracker> instance;
+        if (!instance && qApp) {
+            instance = new QWinUIAcrylicBackdropTracker(qApp);
+        }
+        return instance;
+    }
+
+    void addBrush(QWinUIAcrylicBrush* brush)
+    {
+        if (m_brushes.contains(brush)) {
+            return;
+        }
+        if (m_brushes.isEmpty()) {
+            qApp->installEventFilter(this);
+        }
+        m_brushes.append(brush);
+    }
+
+    void removeBrush(QWinUIAcrylicBrush* brush)
+    {
+        if (m_brushes.removeOne(brush) && m_brushes.isEmpty()) {
+            qApp->removeEventFilter(this);
+        }
+    }
+
+    void beginCapture() { ++m_captureDepth; }
+    void endCapture() { --m_captureDepth; }
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override
+    {
+        if (event->type() != QEvent::Paint || m_captureDepth > 0 || !watched->isWidgetType()) {
+            return false;
+        }
+
+        QWidget* widget = static_cast<QWidget*>(watched);
+        const QRegion& region = static_cast<QPaintEvent*>(event)->region();
+        for (QWinUIAcrylicBrush* brush : std::as_const(m_brushes)) {
+            if (!brush->isVisible()) {
+                continue;
+            }
+            if (widget == brush || brush->isAncestorOf(widget)) {
+                brush->markSelfPainted(widget == brush ? region : region.translated(widget->mapTo(brush, QPoint())));
+                continue;
+            }
+            if (!brush->isBackdropWidget(widget)) {
+                continue;
+            }
+            QWidget* topLevel = brush->window();
+            const QPoint offset = (widget == topLevel ? QPoint() : widget->mapTo(topLevel, QPoint()))
+                                - brush->mapTo(topLevel, QPoint());
+            brush->markBackdropDirty(region.translated(offset));
+        }
+        return false;
+    }
+
+private:
+    explicit QWinUIAcrylicBackdropTracker(QObject* parent)
+        : QObject(parent)
+        , m_captureDepth(0)
+    {
+    }
+
+    QList<QWinUIAcrylicBrush*> m_brushes;
+    int m_captureDepth;
+};
+
+namespace {
+
+// 效果缓存键：尺寸、模糊半径和背景内容都相同的画刷得到相同的结果；
+// 着色参数不参与，着色动画的每一帧不会重新模糊，也不会占用缓存
+struct AcrylicEffectKey {
+    QSize size;     // 设备像素
+    int dprPercent; // 设备像素比 × 100，避免浮点比较
+    double blurRadius;
+    size_t content; // 未处理背景的像素哈希
+
+    bool operator==(const AcrylicEffectKey& other) const {
+        return size == other.size && dprPercent == other.dprPercent
+            && blurRadius == other.blurRadius && content == other.content;
+    }
+};
+
+size_t qHash(const AcrylicEffectKey& key, size_t seed)
+{
+    return qHashMulti(seed, key.size.width(), key.size.height(), key.dprPercent, key.blurRadius, key.content);
+}
+
+} // namespace
+
+// 进程内共享的亚克力效果缓存（内部类）
+// 按字节计费（以KB为单位），超出上限时淘汰最久未使用的结果；
+// 返回的 QImage 与缓存共享数据，画刷之后局部更新时才会复制
+class QWinUIAcrylicEffectCache
+{
+public:
+    static QWinUIAcrylicEffectCache* getInstance()
+    {
+        static QWinUIAcrylicEffectCache instance;
+        return &instance;
+    }
+
+    QImage find(const AcrylicEffectKey& key) const
+    {
+        const QImage* image = m_cache.object(key);
+        return image ? *image : QImage();
+    }
+
+    void insert(const AcrylicEffectKey& key, const QImage& image)
+    {
+        m_cache.insert(key, new QImage(image), cost(image));
+    }
+
+    void setByteLimit(qint64 maxBytes)
+    {
+        m_cache.setMaxCost(int(qBound<qint64>(0, maxBytes / 1024, std::numeric_limits<int>::max())));
+    }
+
+    qint64 byteLimit() const
+    {
+        return qint64(m_cache.maxCost()) * 1024;
+    }
+
+private:
+    QWinUIAcrylicEffectCache()
+        : m_cache(int(QWinUIAcrylicBrush::DEFAULT_EFFECT_CACHE_BYTES / 1024))
+    {
+    }
+
+    static int cost(const QImage& image)
+    {
+        return int(qMin<qint64>(image.sizeInBytes() / 1024 + 1, std::numeric_limits<int>::max()));
+    }
+
+    QCache<AcrylicEffectKey, QImage> m_cache;
+};
+
+namespace {
+
+// 进程内共享的噪声纹理，每个设备像素比生成一次；
+// 直接写入扫描线，使用 xorshift 伪随机数，不逐像素构造 QColor
+QPixmap sharedNoiseTexture(qreal devicePixelRatio)
+{
+    static QHash<int, QPixmap> textures;
+    const int dprPercent = qRound(devicePixelRatio * 100);
+    auto it = textures.constFind(dprPercent);
+    if (it != textures.constEnd()) {
+        return it.value();
+    }
+
+    // 逻辑尺寸64像素，按设备像素生成，高DPI屏幕上颗粒不会被放大
+    const int textureSize = qCeil(64 * devicePixelRatio);
+    QImage noiseImage(textureSize, textureSize, QImage::Format_ARGB32_Premultiplied);
+
+    const quint32 alpha = 25; // 低透明度
+    quint32 state = 0x9E3779B9u;
+    for (int y = 0; y < textureSize; ++y) {
+        quint32* line = reinterpret_cast<quint32*>(noiseImage.scanLine(y));
+        for (int x = 0; x < textureSize; ++x) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            // 灰度取 [20, 235)，避免极端值；预乘透明度
+            const quint32 gray = 20 + quint32((quint64(state) * 215) >> 32);
+            const quint32 value = (gray * alpha + 127) / 255;
+            line[x] = (alpha << 24) | (value << 16) | (value << 8) | value;
+        }
+    }
+    noiseImage.setDevicePixelRatio(devicePixelRatio);
+
+    // 像素图须在图形系统销毁之前释放
+    if (textures.isEmpty()) {
+        qAddPostRoutine([]() { textures.clear(); });
+    }
+    const QPixmap texture = QPixmap::fromImage(noiseImage);
+    textures.insert(dprPercent, texture);
+    return texture;
+}
+
+// 把 patch 写入 target 的 position 处，返回像素是否有变化（两者均为 ARGB32_Premultiplied）
+bool blitIfChanged(const QImage& patch, QImage* target, const QPoint& position)
+{
+    const QRect area = QRect(position, patch.size()) & target->rect();
+    const int bytes = area.width() * 4;
+    bool changed = false;
+    for (int y = area.top(); y <= area.bottom(); ++y) {
+        const uchar* source = patch.constScanLine(y - position.y()) + (area.left() - position.x()) * 4;
+        // 先只读比较：target 可能与效果缓存共享数据，只有真正写入时才复制
+        const uchar* current = target->constScanLine(y) + area.left() * 4;
+        if (std::memcmp(source, current, bytes) != 0) {
+            std::memcpy(target->scanLine(y) + area.left() * 4, source, bytes);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+// 逻辑坐标矩形对应的设备像素矩形
+QRect toDeviceRect(const QRect& rect, qreal devicePixelRatio)
+{
+    return QRectF(rect.x() * devicePixelRatio, rect.y() * devicePixelRatio,
+                  rect.width() * devicePixelRatio, rect.height() * devicePixelRatio).toAlignedRect();
+}
+
+} // namespace
 
 QWinUIAcrylicBrush::QWinUIAcrylicBrush(QWidget* parent)
     : QWinUIWidget(parent)
@@ -24,18 +242,19 @@ QWinUIAcrylicBrush::QWinUIAcrylicBrush(QWidget* parent)
     , m_blurRadius(DEFAULT_BLUR_RADIUS)
     , m_noiseOpacity(DEFAULT_NOISE_OPACITY)
     , m_needsBackgroundUpdate(true)
+    , m_backdropRefreshPending(false)
     , m_isCapturing(false)
     , m_tintOpacityAnimation(nullptr)
     , m_tintColorAnimation(nullptr)
-    , m_updateTimer(nullptr)
+    , m_geometryTimer(nullptr)
 {
     initializeComponent();
 }
 
 QWinUIAcrylicBrush::~QWinUIAcrylicBrush()
 {
-    if (m_updateTimer) {
-        m_updateTimer->stop();
+    if (QWinUIAcrylicBackdropTracker* tracker = QWinUIAcrylicBackdropTracker::getInstance()) {
+        tracker->removeBrush(this);
     }
 }
 
@@ -45,24 +264,20 @@ void QWinUIAcrylicBrush::initializeComponent()
     setAttribute(Qt::WA_TranslucentBackground);
     setAutoFillBackground(false);
 
+    // 尺寸、位置停止变化后整体刷新一次背景
+    m_geometryTimer = new QTimer(this);
+    m_geometryTimer->setSingleShot(true);
+    m_geometryTimer->setInterval(GEOMETRY_SETTLE_MS);
+    connect(m_geometryTimer, &QTimer::timeout, this, &QWinUIAcrylicBrush::scheduleBackdropRefresh);
+
     // 初始化主题颜色
     updateThemeColors();
 
-    // 生成噪声纹理
-    generateNoiseTexture();
-
     // 设置动画
     setupAnimations();
 
     // 应用亚克力样式
     applyAcrylicStyle();
-
-    // 连接主题变化信号
-    auto theme = QWinUITheme::getInstance();
-    if (theme) {
-        connect(theme, &QWinUITheme::themeChanged,
-                this, &QWinUIAcrylicBrush::updateThemeColors);
-    }
 }
 
 void QWinUIAcrylicBrush::setupAnimations()
@@ -89,7 +304,7 @@ void QWinUIAcrylicBrush::setTintColor(const QColor& color)
 {
     if (m_tintColor != color) {
         m_tintColor = color;
-        applyAcrylicStyle();
+        applyTintChange();
         emit tintColorChanged(color);
     }
 }
@@ -104,7 +319,7 @@ void QWinUIAcrylicBrush::setTintOpacity(double opacity)
     opacity = qBound(0.0, opacity, 1.0);
     if (!qFuzzyCompare(m_tintOpacity, opacity)) {
         m_tintOpacity = opacity;
-        applyAcrylicStyle();
+        applyTintChange();
         emit tintOpacityChanged(opacity);
     }
 }
@@ -135,8 +350,7 @@ void QWinUIAcrylicBrush::setTintLuminosityOpacity(double opacity)
     opacity = qBound(0.0, opacity, 1.0);
     if (!qFuzzyCompare(m_tintLuminosityOpacity, opacity)) {
         m_tintLuminosityOpacity = opacity;
-        m_needsBackgroundUpdate = true;
-        update();
+        applyTintChange();
         emit tintLuminosityOpacityChanged(opacity);
     }
 }
@@ -151,7 +365,7 @@ void QWinUIAcrylicBrush::setBackgroundSource(QWinUIAcrylicBackgroundSource sourc
     if (m_backgroundSource != source) {
         m_backgroundSource = source;
         m_needsBackgroundUpdate = true;
-        update();
+        applyAcrylicStyle();
         emit backgroundSourceChanged(source);
     }
 }
@@ -204,17 +418,24 @@ void QWinUIAcrylicBrush::updateThemeColors()
 {
     auto theme = QWinUITheme::getInstance();
 
+    QColor tintColor;
+    QColor fallbackColor;
     if (theme && theme->isDarkMode()) {
         // 深色主题
-        m_tintColor = QColor(32, 32, 32, 204);
-        m_fallbackColor = QColor(32, 32, 32);
+        tintColor = QColor(32, 32, 32, 204);
+        fallbackColor = QColor(32, 32, 32);
     } else {
         // 浅色主题
-        m_tintColor = QColor(243, 243, 243, 204);
-        m_fallbackColor = QColor(243, 243, 243);
+        tintColor = QColor(243, 243, 243, 204);
+        fallbackColor = QColor(243, 243, 243);
     }
 
-    applyAcrylicStyle();
+    if (tintColor == m_tintColor && fallbackColor == m_fallbackColor) {
+        return;
+    }
+    m_tintColor = tintColor;
+    m_fallbackColor = fallbackColor;
+    applyTintChange();
 }
 
 QSize QWinUIAcrylicBrush::sizeHint() const
@@ -227,41 +448,89 @@ QSize QWinUIAcrylicBrush::minimumSizeHint() const
     return QSize(50, 50);
 }
 
-// paintEvent已移除，使用样式表和图形效果实现亚克力效果
+void QWinUIAcrylicBrush::paintEvent(QPaintEvent* event)
+{
+    // HostBackdrop 背景源仍由样式表和图形效果绘制
+    if (!usesBackdropCapture()) {
+        QWinUIWidget::paintEvent(event);
+        return;
+    }
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    QPainterPath path;
+    path.addRoundedRect(QRectF(rect()).adjusted(0.5, 0.5, -0.5, -0.5), CORNER_RADIUS, CORNER_RADIUS);
+
+    if (m_cachedEffect.isNull()) {
+        // 首次抓取完成前先用备用颜色填充
+        painter.fillPath(path, m_fallbackColor);
+        scheduleBackdropRefresh();
+    } else {
+        painter.save();
+        painter.setClipPath(path);
+        if (m_cachedEffect.deviceIndependentSize() == QSizeF(size())) {
+            painter.drawImage(QPointF(0, 0), m_cachedEffect);
+        } else {
+            // 调整尺寸期间拉伸旧结果，停止变化后再重新生成
+            painter.setRenderHint(QPainter::SmoothPixmapTransform);
+            painter.drawImage(QRectF(rect()), m_cachedEffect);
+        }
+        paintTintLayers(&painter);
+
+        // 细微的噪声纹理
+        if (m_noiseOpacity > 0.0) {
+            painter.setOpacity(m_noiseOpacity);
+            painter.drawTiledPixmap(rect(), sharedNoiseTexture(devicePixelRatioF()));
+        }
+        painter.restore();
+    }
+
+    // 边框
+    QColor borderColor = m_tintColor;
+    borderColor.setAlphaF(0.2);
+    painter.setPen(QPen(borderColor, 1.0));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawPath(path);
+}
 
 void QWinUIAcrylicBrush::resizeEvent(QResizeEvent* event)
 {
     QWinUIWidget::resizeEvent(event);
+
+    // HostBackdrop 背景源由样式表绘制，尺寸变化无需额外处理
     m_needsBackgroundUpdate = true;
+    if (usesBackdropCapture()) {
+        deferBackdropRefresh();
+    }
+}
 
-    // 使用单次定时器延迟更新，避免频繁重绘
-    QTimer::singleShot(100, this, [this]() {
-        if (m_needsBackgroundUpdate) {
-            update();
-        }
-    });
+void QWinUIAcrylicBrush::moveEvent(QMoveEvent* event)
+{
+    QWinUIWidget::moveEvent(event);
+
+    // 移动后下方的内容整体改变
+    if (usesBackdropCapture()) {
+        m_needsBackgroundUpdate = true;
+        deferBackdropRefresh();
+    }
 }
 
 void QWinUIAcrylicBrush::showEvent(QShowEvent* event)
 {
     QWinUIWidget::showEvent(event);
-    m_needsBackgroundUpdate = true;
 
-    // 延迟更新，避免在显示事件中立即触发重绘
-    QTimer::singleShot(50, this, [this]() {
-        if (isVisible() && m_needsBackgroundUpdate) {
-            update();
-        }
-    });
+    // 隐藏期间下方的变化没有跟踪，显示时整体重新抓取
+    m_needsBackgroundUpdate = true;
+    if (usesBackdropCapture()) {
+        scheduleBackdropRefresh();
+    }
 }
 
 void QWinUIAcrylicBrush::hideEvent(QHideEvent* event)
 {
     QWinUIWidget::hideEvent(event);
-
-    if (m_updateTimer) {
-        m_updateTimer->stop();
-    }
+    m_geometryTimer->stop();
 }
 
 void QWinUIAcrylicBrush::onThemeChanged()
@@ -271,95 +540,311 @@ void QWinUIAcrylicBrush::onThemeChanged()
 
 void QWinUIAcrylicBrush::updateBackgroundCapture()
 {
+    m_backdropRefreshPending = false;
+    const QRegion selfPainted = m_selfPainted;
+    m_selfPainted = QRegion();
     if (!isVisible() || m_isCapturing) {
         return;
     }
 
-    // 停止定时器，避免频繁更新
-    if (m_updateTimer) {
-        m_updateTimer->stop();
+    // 尺寸或位置仍在变化，等停止后整体刷新，期间的脏区域一并丢弃
+    if (m_geometryTimer->isActive()) {
+        m_dirtyBackdrop = QRegion();
+        return;
     }
 
-    m_needsBackgroundUpdate = true;
-    update();
+    if (!usesBackdropCapture()) {
+        m_needsBackgroundUpdate = true;
+        update();
+        return;
+    }
+
+    // 画刷自身重绘（着色动画、子控件悬停等）带动的下方重绘不是背景变化，不重新抓取；
+    // 同一轮中恰好落在这片区域内的背景变化也会被忽略，直到下方再次重绘
+    const QRegion dirty = m_needsBackgroundUpdate ? QRegion(rect()) : m_dirtyBackdrop - selfPainted;
+    m_dirtyBackdrop = QRegion();
+    if (dirty.isEmpty() && !m_cachedEffect.isNull()) {
+        return;
+    }
+
+    // 内容没有变化时不重绘
+    const QRegion changed = captureBackground(dirty);
+    if (!changed.isEmpty()) {
+        update(changed);
+    }
+}
+
+bool QWinUIAcrylicBrush::usesBackdropCapture() const
+{
+    return m_isEffectEnabled && m_backgroundSource == QWinUIAcrylicBackgroundSource::Backdrop;
+}
+
+bool QWinUIAcrylicBrush::isBackdropWidget(const QWidget* widget) const
+{
+    if (!widget || widget == this || isAncestorOf(widget) || widget->window() != window()) {
+        return false;
+    }
+    if (widget->isAncestorOf(this)) {
+        return true;
+    }
+
+    // 找到共同祖先，比较两者所在分支的层叠顺序（子控件列表中靠前的在下方）
+    const QWidget* mine = this;
+    const QWidget* common = parentWidget();
+    while (common && !common->isAncestorOf(widget)) {
+        mine = common;
+        common = common->parentWidget();
+    }
+    if (!common) {
+        return false;
+    }
+
+    const QWidget* theirs = widget;
+    while (theirs->parentWidget() != common) {
+        theirs = theirs->parentWidget();
+    }
+
+    const QObjectList& children = common->children();
+    return children.indexOf(const_cast<QWidget*>(theirs)) < children.indexOf(const_cast<QWidget*>(mine));
 }
 
-void QWinUIAcrylicBrush::captureBackground()
+void QWinUIAcrylicBrush::markBackdropDirty(const QRegion& region)
 {
-    if (m_isCapturing || !isVisible()) {
+    const QRegion dirty = region & rect();
+    if (dirty.isEmpty()) {
         return;
     }
 
-    m_isCapturing = true;
+    m_dirtyBackdrop += dirty;
+    scheduleBackdropRefresh();
+}
 
-    // 暂时使用简单的渐变背景，避免复杂的背景捕获导致的性能问题
-    QPixmap background(size());
-    background.fill(Qt::transparent);
+void QWinUIAcrylicBrush::markSelfPainted(const QRegion& region)
+{
+    // 下方的重绘先于画刷自身送达，此时抓取已排队；没有排队时说明下方没有重绘，无需记录
+    if (m_backdropRefreshPending) {
+        m_selfPainted += region & rect();
+    }
+}
 
-    QPainter painter(&background);
-    painter.setRenderHint(QPainter::Antialiasing);
+void QWinUIAcrylicBrush::scheduleBackdropRefresh()
+{
+    // 下方控件在本轮绘制完成后才是新内容，排队到事件循环中抓取
+    if (m_backdropRefreshPending) {
+        return;
+    }
+    m_backdropRefreshPending = true;
+    QMetaObject::invokeMethod(this, &QWinUIAcrylicBrush::updateBackgroundCapture, Qt::QueuedConnection);
+}
+
+void QWinUIAcrylicBrush::deferBackdropRefresh()
+{
+    // 还没有结果时立即抓取；否则拖动期间沿用旧结果（绘制时拉伸到新尺寸），
+    // 每次变化都重新开始计时，停止变化后才重新抓取和模糊
+    if (m_cachedEffect.isNull()) {
+        scheduleBackdropRefresh();
+        return;
+    }
+    m_geometryTimer->start();
+    update();
+}
+
+QRegion QWinUIAcrylicBrush::captureBackground(const QRegion& region)
+{
+    if (m_isCapturing || !isVisible() || size().isEmpty()) {
+        return QRegion();
+    }
+
+    // 按设备像素抓取，避免高DPI屏幕上绘制时再放大
+    const qreal dpr = devicePixelRatioF();
+    const QSize deviceSize = toDeviceRect(rect(), dpr).size();
+    QRegion dirty = region & rect();
+    if (m_backgroundCapture.size() != deviceSize || !qFuzzyCompare(m_backgroundCapture.devicePixelRatio(), dpr)) {
+        m_backgroundCapture = QImage(deviceSize, QImage::Format_ARGB32_Premultiplied);
+        m_backgroundCapture.setDevicePixelRatio(dpr);
+        m_backgroundCapture.fill(Qt::transparent);
+        m_cachedEffect = QImage();
+        dirty = rect();
+    }
+    m_needsBackgroundUpdate = false;
+
+    QList<QRect> rects;
+    if (dirty.rectCount() > MAX_DIRTY_RECTS) {
+        rects.append(dirty.boundingRect());
+    } else {
+        rects = QList<QRect>(dirty.begin(), dirty.end());
+    }
 
-    // 创建简单的渐变背景
-    QLinearGradient gradient(0, 0, width(), height());
-    gradient.setColorAt(0, QColor(200, 200, 200, 100));
-    gradient.setColorAt(1, QColor(150, 150, 150, 100));
+    m_isCapturing = true;
+    QWinUIAcrylicBackdropTracker* tracker = QWinUIAcrylicBackdropTracker::getInstance();
+    tracker->beginCapture();
+
+    QRegion changed;
+    for (const QRect& dirtyRect : std::as_const(rects)) {
+        const QRect deviceRect = toDeviceRect(dirtyRect, dpr) & m_backgroundCapture.rect();
+        if (deviceRect.isEmpty()) {
+            continue;
+        }
 
-    painter.fillRect(background.rect(), gradient);
+        QImage patch(deviceRect.size(), QImage::Format_ARGB32_Premultiplied);
+        patch.setDevicePixelRatio(dpr);
+        patch.fill(Qt::transparent);
+        {
+            QPainter painter(&patch);
+            painter.translate(-QPointF(deviceRect.topLeft()) / dpr);
+            renderBackdrop(&painter, dirtyRect);
+        }
 
-    if (!background.isNull()) {
-        m_backgroundCapture = background;
-        m_cachedEffect = applyAcrylicEffect(background);
+        if (blitIfChanged(patch, &m_backgroundCapture, deviceRect.topLeft())) {
+            changed += dirtyRect;
+        }
     }
 
+    tracker->endCapture();
     m_isCapturing = false;
+
+    // 重新模糊变化的区域
+    if (m_cachedEffect.isNull()) {
+        m_cachedEffect = sharedBlurredBackdrop(m_backgroundCapture);
+        return rect();
+    }
+
+    QRegion repaint;
+    for (const QRect& changedRect : changed) {
+        repaint += updateEffect(changedRect);
+    }
+    return repaint;
 }
 
-QPixmap QWinUIAcrylicBrush::applyAcrylicEffect(const QPixmap& background)
+void QWinUIAcrylicBrush::renderBackdrop(QPainter* painter, const QRect& rect)
 {
-    if (background.isNull()) {
-        return QPixmap();
+    // 从顶层窗口到画刷逐层绘制：每层先绘制祖先自身（不含子控件），
+    // 再绘制层叠顺序在该分支之下的兄弟控件及其子控件
+    QList<QWidget*> chain;
+    for (QWidget* widget = this; widget; widget = widget->isWindow() ? nullptr : widget->parentWidget()) {
+        chain.prepend(widget);
     }
 
-    QPixmap result = background;
+    QWidget* topLevel = chain.first();
+    const QPoint origin = mapTo(topLevel, QPoint());
 
-    // 1. 应用模糊效果
-    if (m_blurRadius > 0.0) {
-        QGraphicsScene scene;
-        QGraphicsPixmapItem* item = scene.addPixmap(result);
+    for (int i = 0; i + 1 < chain.size(); ++i) {
+        QWidget* ancestor = chain.at(i);
+        QWidget* branch = chain.at(i + 1);
+        const QPoint offset = (ancestor == topLevel ? QPoint() : ancestor->mapTo(topLevel, QPoint())) - origin;
 
-        QGraphicsBlurEffect* blurEffect = new QGraphicsBlurEffect();
-        blurEffect->setBlurRadius(m_blurRadius);
-        blurEffect->setBlurHints(QGraphicsBlurEffect::QualityHint);
-        item->setGraphicsEffect(blurEffect);
+        // render() 把区域的左上角（而不是控件原点）绘制在 targetOffset 处
+        const QRegion ancestorRegion = QRegion(rect.translated(-offset)) & ancestor->rect();
+        if (!ancestorRegion.isEmpty()) {
+            ancestor->render(painter, offset + ancestorRegion.boundingRect().topLeft(), ancestorRegion,
+                             QWidget::DrawWindowBackground);
+        }
+
+        for (QObject* child : ancestor->children()) {
+            if (child == branch) {
+                break;
+            }
+
+            QWidget* sibling = qobject_cast<QWidget*>(child);
+            if (!sibling || sibling->isWindow() || !sibling->isVisible()) {
+                continue;
+            }
+
+            const QPoint siblingOffset = offset + sibling->pos();
+            const QRect siblingRect(siblingOffset, sibling->size());
+            if (!siblingRect.intersects(rect)) {
+                continue;
+            }
+            const QRegion siblingRegion = QRegion(rect.translated(-siblingOffset)) & sibling->rect();
+            sibling->render(painter, siblingOffset + siblingRegion.boundingRect().topLeft(), siblingRegion,
+                            QWidget::DrawWindowBackground | QWidget::DrawChildren);
+        }
+    }
+}
 
-        QPixmap blurred(result.size());
-        blurred.fill(Qt::transparent);
+QRect QWinUIAcrylicBrush::updateEffect(const QRect& rect)
+{
+    // 模糊结果受半径范围内的背景影响：受影响区域向外扩展一个半径，
+    // 计算时再向外取一个半径的背景作为输入
+    const qreal dpr = m_backgroundCapture.devicePixelRatio();
+    const int margin = qCeil(m_blurRadius * dpr);
+    const QRect bounds = m_backgroundCapture.rect();
+    const QRect target = toDeviceRect(rect, dpr).adjusted(-margin, -margin, margin, margin) & bounds;
+    // 输入区域按缩小倍数对齐，各块缩小后的采样网格与整图一致，拼接处没有接缝
+    const int factor = QWinUIImageBlur::downsampleFactor(m_blurRadius, dpr);
+    QRect source = target.adjusted(-margin, -margin, margin, margin);
+    source.setLeft(qFloor(source.left() / qreal(factor)) * factor);
+    source.setTop(qFloor(source.top() / qreal(factor)) * factor);
+    source &= bounds;
+    if (target.isEmpty()) {
+        return QRect();
+    }
 
-        QPainter painter(&blurred);
-        painter.setRenderHint(QPainter::Antialiasing);
-        scene.render(&painter);
+    const QImage processed = blurBackdrop(m_backgroundCapture.copy(source));
+    blitIfChanged(processed.copy(target.translated(-source.topLeft())), &m_cachedEffect, target.topLeft());
 
-        result = blurred;
+    return QRectF(target.x() / dpr, target.y() / dpr, target.width() / dpr, target.height() / dpr).toAlignedRect();
+}
+
+QImage QWinUIAcrylicBrush::sharedBlurredBackdrop(const QImage& background)
+{
+    if (background.isNull()) {
+        return QImage();
     }
 
-    // 2. 应用着色层
-    QPainter painter(&result);
-    painter.setRenderHint(QPainter::Antialiasing);
-    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    // 哈希只需遍历一次像素，远比模糊便宜
+    const AcrylicEffectKey key = {
+        background.size(),
+        qRound(background.devicePixelRatio() * 100),
+        m_blurRadius,
+        qHashBits(background.constBits(), size_t(background.sizeInBytes()))
+    };
+
+    QWinUIAcrylicEffectCache* cache = QWinUIAcrylicEffectCache::getInstance();
+    QImage result = cache->find(key);
+    if (result.isNull()) {
+        result = blurBackdrop(background);
+        cache->insert(key, result);
+    }
+    return result;
+}
 
-    // 计算亮度调节颜色
+void QWinUIAcrylicBrush::setEffectCacheByteLimit(qint64 maxBytes)
+{
+    QWinUIAcrylicEffectCache::getInstance()->setByteLimit(maxBytes);
+}
+
+qint64 QWinUIAcrylicBrush::effectCacheByteLimit()
+{
+    return QWinUIAcrylicEffectCache::getInstance()->byteLimit();
+}
+
+QImage QWinUIAcrylicBrush::blurBackdrop(const QImage& background)
+{
+    if (background.isNull()) {
+        return QImage();
+    }
+
+    QImage result = background.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    // 边缘按最近像素延伸，结果与原图大小一致，分块处理时各块才能对齐
+    if (m_blurRadius > 0.0) {
+        result = QWinUIImageBlur::blur(result, m_blurRadius);
+    }
+    return result;
+}
+
+void QWinUIAcrylicBrush::paintTintLayers(QPainter* painter)
+{
+    // 亮度层
     QColor luminosityColor = calculateLuminosityColor();
     luminosityColor.setAlphaF(m_tintLuminosityOpacity);
+    painter->fillRect(rect(), luminosityColor);
 
-    // 绘制亮度层
-    painter.fillRect(result.rect(), luminosityColor);
-
-    // 绘制着色层
+    // 着色层
     QColor tintColorWithOpacity = m_tintColor;
     tintColorWithOpacity.setAlphaF(m_tintOpacity);
-    painter.fillRect(result.rect(), tintColorWithOpacity);
-
-    return result;
+    painter->fillRect(rect(), tintColorWithOpacity);
 }
 
 QColor QWinUIAcrylicBrush::calculateLuminosityColor() const
@@ -383,26 +868,6 @@ QColor QWinUIAcrylicBrush::calculateLuminosityColor() const
     return luminosityColor;
 }
 
-void QWinUIAcrylicBrush::generateNoiseTexture()
-{
-    // 生成细微的噪声纹理以增加真实感
-    const int textureSize = 64;
-    QImage noiseImage(textureSize, textureSize, QImage::Format_ARGB32);
-
-    QRandomGenerator* generator = QRandomGenerator::global();
-
-    for (int y = 0; y < textureSize; ++y) {
-        for (int x = 0; x < textureSize; ++x) {
-            // 生成随机灰度值
-            int gray = generator->bounded(20, 235); // 避免极端值
-            QColor noiseColor(gray, gray, gray, 25); // 低透明度
-            noiseImage.setPixelColor(x, y, noiseColor);
-        }
-    }
-
-    m_noiseTexture = QPixmap::fromImage(noiseImage);
-}
-
 bool QWinUIAcrylicBrush::shouldUseFallback() const
 {
     // 检查是否应该使用备用颜色
@@ -422,19 +887,6 @@ bool QWinUIAcrylicBrush::shouldUseFallback() const
     return false;
 }
 
-void QWinUIAcrylicBrush::updateEffectState()
-{
-    if (m_updateTimer) {
-        m_updateTimer->stop();
-    }
-
-    if (m_isEffectEnabled && isVisible()) {
-        m_needsBackgroundUpdate = true;
-    }
-
-    update();
-}
-
 // 预设样式方法
 void QWinUIAcrylicBrush::applyNavigationPanelStyle()
 {
@@ -554,11 +1006,46 @@ void QWinUIAcrylicBrush::onTintOpacityAnimationFinished()
 void QWinUIAcrylicBrush::onTintColorAnimationFinished()
 {
     // 颜色动画完成后的处理
+    applyTintChange();
+}
+
+void QWinUIAcrylicBrush::applyTintChange()
+{
+    // 抓取背景时着色层在绘制时叠加，只需重绘；样式表方式的颜色写在样式表里
+    if (usesBackdropCapture()) {
+        update();
+        return;
+    }
     applyAcrylicStyle();
 }
 
 void QWinUIAcrylicBrush::applyAcrylicStyle()
 {
+    QWinUIAcrylicBackdropTracker* tracker = QWinUIAcrylicBackdropTracker::getInstance();
+    if (usesBackdropCapture()) {
+        // 自行绘制抓取到的背景，不使用样式表和图形效果
+        setStyleSheet(QString());
+        setGraphicsEffect(nullptr);
+        if (tracker) {
+            tracker->addBrush(this);
+        }
+
+        // 模糊半径变化只需用已有的背景重新模糊
+        if (!m_needsBackgroundUpdate && !m_backgroundCapture.isNull()) {
+            m_cachedEffect = sharedBlurredBackdrop(m_backgroundCapture);
+        } else {
+            scheduleBackdropRefresh();
+        }
+        update();
+        return;
+    }
+
+    // 不再跟踪下方的重绘，切回时需要整体重新抓取
+    if (tracker) {
+        tracker->removeBrush(this);
+    }
+    m_needsBackgroundUpdate = true;
+
     if (!m_isEffectEnabled) {
         // 禁用效果时使用简单背景
         setStyleSheet(QString("QWinUIAcrylicBrush { background-color: %1; border-radius: 8px; }")
@@ -606,19 +1093,7 @@ QString QWinUIAcrylicBrush::createAcrylicStyleSheet()
 
 void QWinUIAcrylicBrush::applyBlurEffect()
 {
-    // 移除现有的图形效果
-    if (graphicsEffect()) {
-        delete graphicsEffect();
-    }
-
-    if (!m_isEffectEnabled || m_blurRadius <= 0) {
-        return;
-    }
-
-    // 创建模糊效果
-    QGraphicsBlurEffect* blurEffect = new QGraphicsBlurEffect(this);
-    blurEffect->setBlurRadius(m_blurRadius * 0.3); // 减少模糊半径，避免过度模糊
-    blurEffect->setBlurHints(QGraphicsBlurEffect::QualityHint);
-
-    setGraphicsEffect(blurEffect);
+    // 宿主背景模式由系统合成器模糊窗口后方的内容；
+    // 在控件上再挂模糊效果只会把自身的渐变和边框糊掉，因此只移除已有的图形效果
+    setGraphicsEffect(nullptr);
 }
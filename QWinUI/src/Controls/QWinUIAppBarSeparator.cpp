@@ -34,11 +34,6 @@ void QWinUIAppBarSeparator::initializeSeparator()
     setShadowDepth(QWinUIShadowDepth::None); // 分隔线不需要阴影
     setFocusPolicy(Qt::NoFocus); // 分隔线不需要焦点
 
-    // 连接主题变化信号
-    if (QWinUITheme* theme = QWinUITheme::getInstance()) {
-        connect(theme, &QWinUITheme::themeChanged, this, &QWinUIAppBarSeparator::onThemeChanged);
-    }
-
     updateSeparatorAppearance();
 
     // 确保在初始化时立即更新一次，以获取正确的主题颜色
@@ -329,7 +329,7 @@ void QWinUIContentDialog::resizeEvent(QResizeEvent* event)
 
 void QWinUIContentDialog::showEvent(QShowEvent* event)
 {
-    QWidget::showEvent(event);
+    QWinUIWidget::showEvent(event);
     updateDialogPosition();
 }
 
@@ -29,22 +29,6 @@ QWinUIDropDownButton::QWinUIDropDownButton(QWidget* parent)
 
     // 连接按钮点击信号到显示菜单
     connect(this, &QWinUIButton::clicked, this, &QWinUIDropDownButton::showFlyout);
-
-    // 连接主题变化信号
-    QWinUITheme* theme = QWinUITheme::getInstance();
-    if (theme) {
-        connect(theme, &QWinUITheme::themeChanged, this, [this]() {
-            update(); // 主题变化时重新绘制
-        });
-
-        // 连接颜色变化信号
-        connect(theme, &QWinUITheme::colorChanged, this, [this](const QString& colorName, const QColor& color) {
-            Q_UNUSED(colorName)
-            Q_UNUSED(color)
-            update(); // 颜色变化时重新绘制
-        });
-
-    }
 }
 
 void QWinUIDropDownButton::setArrowOffset(double offset)
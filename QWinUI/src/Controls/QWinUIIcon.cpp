@@ -1,6 +1,7 @@
 #include "QWinUI/Controls/QWinUIIcon.h"
 #include "QWinUI/QWinUIIconManager.h"
 #include "QWinUI/QWinUITheme.h"
+#include "QWinUI/QWinUIFluentIcons.h"
 #include <QPainter>
 #include <QMouseEvent>
 #include <QPropertyAnimation>
@@ -20,6 +21,7 @@ QWinUIIcon::QWinUIIcon(QWidget* parent)
     , m_isHovered(false)
     , m_isDynamicSvg(false)
     , m_isFontIcon(false)
+    , m_cachedDevicePixelRatio(1.0)
     , m_rotationAnimation(nullptr)
     , m_opacityAnimation(nullptr)
     , m_spinAnimation(nullptr)
@@ -341,14 +343,21 @@ bool QWinUIIcon::isValid() const
         return false;
     }
 
-    // 直接检查资源文件是否存在，不依赖图标管理器
+    // 资源文件或图标包中存在即可
     QString resourcePath = getResourcePath(m_iconName);
-    QFile file(resourcePath);
-    return file.exists();
+    return QWinUIIconManager::getInstance()->hasIconFile(resourcePath);
 }
 
 QPixmap QWinUIIcon::getPixmap() const
 {
+    return loadPixmap(false, nullptr);
+}
+
+QPixmap QWinUIIcon::loadPixmap(bool async, bool* ready) const
+{
+    if (ready) {
+        *ready = true;
+    }
     if (!isValid()) {
         return QPixmap();
     }
@@ -358,61 +367,50 @@ QPixmap QWinUIIcon::getPixmap() const
         return renderFontIcon();
     }
 
-    QSvgRenderer renderer;
-    QString debugPath = "unknown";
+    // 黑色视为SVG原色，不做着色
+    QColor effectiveColor = getEffectiveIconColor();
+    if (!effectiveColor.isValid() || effectiveColor == Qt::black) {
+        effectiveColor = QColor();
+    }
 
-    if (m_isDynamicSvg) {
-        // 使用动态SVG数据
-        qDebug() << "Loading dynamic SVG data, size:" << m_dynamicSvgData.size();
-        renderer.load(m_dynamicSvgData);
-        debugPath = "dynamic_svg_data";
-    } else {
-        // 从资源加载SVG
+    // 资源图标走图标管理器的共享缓存：同一SVG只解析一次，光栅图按尺寸和颜色复用
+    if (!m_isDynamicSvg) {
         QString resourcePath = getResourcePath(m_iconName);
-        qDebug() << "Loading icon:" << m_iconName << "from path:" << resourcePath;
-        renderer.load(resourcePath);
-        debugPath = resourcePath;
+        QWinUIIconManager* manager = QWinUIIconManager::getInstance();
+        QPixmap pixmap = async
+            ? manager->requestIconFromFile(resourcePath, m_iconSize, effectiveColor, devicePixelRatioF(), ready)
+            : manager->getIconFromFile(resourcePath, m_iconSize, effectiveColor, devicePixelRatioF());
+        if (pixmap.isNull()) {
+            qWarning() << "Failed to load SVG from:" << resourcePath;
+            // 创建一个调试用的彩色方块
+            QPixmap debugPixmap(m_iconSize);
+            debugPixmap.fill(Qt::red);
+            return debugPixmap;
+        }
+        return pixmap;
     }
 
+    // 动态SVG数据只属于当前控件，直接渲染
+    QSvgRenderer renderer(m_dynamicSvgData);
     if (!renderer.isValid()) {
-        qWarning() << "Failed to load SVG from:" << debugPath;
-        // 创建一个调试用的彩色方块
+        qWarning() << "Failed to load dynamic SVG data";
         QPixmap debugPixmap(m_iconSize);
         debugPixmap.fill(Qt::red);
         return debugPixmap;
     }
 
-    // 创建指定尺寸的像素图
-    QPixmap pixmap(m_iconSize);
+    const qreal dpr = devicePixelRatioF();
+    QPixmap pixmap(m_iconSize * dpr);
+    pixmap.setDevicePixelRatio(dpr);
     pixmap.fill(Qt::transparent);
 
-    QPainter painter(&pixmap);
-    painter.setRenderHint(QPainter::Antialiasing);
-
-    // 先渲染SVG
-    renderer.render(&painter);
-
-    // 如果需要应用颜色，使用不同的方法
-    QColor effectiveColor = getEffectiveIconColor();
-    if (effectiveColor.isValid() && effectiveColor != Qt::black) {
-        // 创建一个新的像素图用于着色
-        QPixmap coloredPixmap(m_iconSize);
-        coloredPixmap.fill(Qt::transparent);
-
-        QPainter colorPainter(&coloredPixmap);
-        colorPainter.setRenderHint(QPainter::Antialiasing);
-
-        // 使用源图像作为蒙版
-        colorPainter.setCompositionMode(QPainter::CompositionMode_SourceOver);
-        colorPainter.drawPixmap(0, 0, pixmap);
-
-        colorPainter.setCompositionMode(QPainter::CompositionMode_SourceIn);
-        colorPainter.fillRect(coloredPixmap.rect(), effectiveColor);
-
-        return coloredPixmap;
+    {
+        QPainter painter(&pixmap);
+        painter.setRenderHint(QPainter::Antialiasing);
+        renderer.render(&painter, QRectF(QPointF(0, 0), QSizeF(m_iconSize)));
     }
 
-    return pixmap;
+    return QWinUIIconManager::colorizePixmap(pixmap, effectiveColor);
 }
 
 QSvgRenderer* QWinUIIcon::getRenderer() const
@@ -427,9 +425,9 @@ QSvgRenderer* QWinUIIcon::getRenderer() const
         // 使用动态SVG数据
         renderer->load(m_dynamicSvgData);
     } else {
-        // 从资源加载SVG
+        // 从资源或图标包加载SVG
         QString resourcePath = getResourcePath(m_iconName);
-        renderer->load(resourcePath);
+        renderer->load(QWinUIIconManager::getInstance()->getIconData(resourcePath));
     }
 
     if (!renderer->isValid()) {
@@ -454,8 +452,43 @@ void QWinUIIcon::paintEvent(QPaintEvent* event)
 {
     Q_UNUSED(event)
     
-    if (!isValid()) {
-        return;
+    const QColor effectiveColor = getEffectiveIconColor();
+    
+    // 旋转中的SVG图标直接按变换绘制矢量路径，避免旋转后的位图发虚
+    if (isTransformed() && !m_isFontIcon && !m_isDynamicSvg) {
+        if (!m_cachedVector.isValid() && isValid()) {
+            m_cachedVector = QWinUIIconManager::getInstance()->getIconVectorFromFile(getResourcePath(m_iconName));
+        }
+        if (m_cachedVector.isValid()) {
+            QPainter painter(this);
+            painter.setRenderHint(QPainter::Antialiasing, true);
+            painter.setOpacity(m_iconOpacity);
+            painter.setTransform(getTransform());
+            
+            // 黑色视为SVG原色，不做着色（与 getPixmap 一致）
+            const QColor tint = effectiveColor == Qt::black ? QColor() : effectiveColor;
+            QWinUIIconManager::drawIconVector(&painter, m_cachedVector, QRectF(rect()), tint);
+            return;
+        }
+    }
+    
+    // 光栅图与旋转角度无关，只在图标、尺寸或颜色变化时重新获取，
+    // 静止时每次绘制只是一次位图绘制
+    const qreal dpr = devicePixelRatioF();
+    if (m_cachedPixmap.isNull() || m_cachedColor != effectiveColor
+        || !qFuzzyCompare(m_cachedDevicePixelRatio, dpr)) {
+        if (!isValid()) {
+            return;
+        }
+        // 未命中缓存时先绘制占位图，后台光栅化完成后再替换
+        bool ready = true;
+        m_cachedPixmap = loadPixmap(true, &ready);
+        m_cachedColor = effectiveColor;
+        m_cachedDevicePixelRatio = dpr;
+        if (!ready) {
+            connect(QWinUIIconManager::getInstance(), &QWinUIIconManager::iconReady,
+                    this, &QWinUIIcon::onIconReady, Qt::UniqueConnection);
+        }
     }
     
     QPainter painter(this);
@@ -469,16 +502,6 @@ void QWinUIIcon::paintEvent(QPaintEvent* event)
     QTransform transform = getTransform();
     painter.setTransform(transform);
     
-    // 获取图标
-    QString cacheKey = QString("%1_%2x%3_%4_%5").arg(m_iconName)
-                      .arg(m_iconSize.width()).arg(m_iconSize.height())
-                      .arg(getEffectiveIconColor().name()).arg(m_rotation);
-    
-    if (m_lastCacheKey != cacheKey || m_cachedPixmap.isNull()) {
-        m_cachedPixmap = getPixmap();
-        m_lastCacheKey = cacheKey;
-    }
-    
     if (!m_cachedPixmap.isNull()) {
         QRect targetRect = rect();
         targetRect.moveCenter(rect().center());
@@ -543,6 +566,17 @@ void QWinUIIcon::onThemeChanged()
     QWinUIWidget::onThemeChanged();
 }
 
+QWinUITheme::ColorTokenSet QWinUIIcon::themeColorTokens() const
+{
+    // 指定了固定颜色的图标不受主题影响
+    if (!m_useThemeColor) {
+        return QWinUITheme::ColorTokenSet();
+    }
+    // 图标按深浅模式取前景色，悬停和按下时使用强调色
+    return QWinUITheme::accentColorTokens()
+           | QWinUITheme::colorTokenSet({ QWinUITheme::ColorToken::TextFillColorPrimary });
+}
+
 void QWinUIIcon::onRotationAnimationFinished()
 {
     // 旋转动画完成后的处理
@@ -553,10 +587,35 @@ void QWinUIIcon::onOpacityAnimationFinished()
     // 透明度动画完成后的处理
 }
 
+void QWinUIIcon::onIconReady(const QString& filePath, const QSize& size, qreal devicePixelRatio, const QImage& image)
+{
+    if (m_isFontIcon || m_isDynamicSvg || size != m_iconSize
+        || !qFuzzyCompare(devicePixelRatio, devicePixelRatioF())
+        || filePath != getResourcePath(m_iconName)) {
+        return;
+    }
+
+    disconnect(QWinUIIconManager::getInstance(), &QWinUIIconManager::iconReady,
+               this, &QWinUIIcon::onIconReady);
+
+    // 直接用随信号送达的结果替换占位图；缓存项之后可能被淘汰，再查一次缓存会重新排队
+    const QColor effectiveColor = getEffectiveIconColor();
+    const QColor tint = effectiveColor == Qt::black ? QColor() : effectiveColor;
+    const bool isMask = image.format() == QImage::Format_Alpha8;
+    if (m_cachedColor != effectiveColor || isMask != tint.isValid()) {
+        // 请求发出后颜色已变化，按当前颜色重新获取
+        updateIcon();
+        return;
+    }
+
+    m_cachedPixmap = QPixmap::fromImage(isMask ? QWinUIIconManager::tintAlphaMask(image, tint) : image);
+    update();
+}
+
 void QWinUIIcon::updateIcon()
 {
     m_cachedPixmap = QPixmap(); // 清除缓存
-    m_lastCacheKey.clear();
+    m_cachedVector = QWinUIIconVector();
     update();
 }
 
@@ -576,24 +635,38 @@ QString QWinUIIcon::getResourcePath(const QString& iconName) const
 
 QPixmap QWinUIIcon::renderFontIcon() const
 {
-    QPixmap pixmap(m_iconSize);
+    const qreal dpr = devicePixelRatioF();
+    QPixmap pixmap(m_iconSize * dpr);
+    pixmap.setDevicePixelRatio(dpr);
     pixmap.fill(Qt::transparent);
 
     QPainter painter(&pixmap);
     painter.setRenderHint(QPainter::Antialiasing);
     painter.setRenderHint(QPainter::TextAntialiasing);
 
+    const int pixelSize = qMin(m_iconSize.width(), m_iconSize.height());
+    const QColor effectiveColor = getEffectiveIconColor();
+
+    // 优先填充缓存的字形轮廓，省去每次绘制的字体解析和文本排版
+    const QPainterPath glyphPath = QWinUIIconManager::getInstance()->getGlyphPath(m_fontFamily, m_fontIconChar, pixelSize);
+    if (!glyphPath.isEmpty()) {
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(effectiveColor);
+        painter.translate(QRectF(QPointF(0, 0), QSizeF(m_iconSize)).center());
+        painter.drawPath(glyphPath);
+        return pixmap;
+    }
+
     // 设置字体
     QFont font(m_fontFamily);
-    font.setPixelSize(qMin(m_iconSize.width(), m_iconSize.height()));
+    font.setPixelSize(pixelSize);
     painter.setFont(font);
 
     // 设置颜色
-    QColor effectiveColor = getEffectiveIconColor();
     painter.setPen(effectiveColor);
 
-    // 绘制字符
-    QRect textRect = pixmap.rect();
+    // 绘制字符（逻辑坐标）
+    QRect textRect(QPoint(0, 0), m_iconSize);
     painter.drawText(textRect, Qt::AlignCenter, QString(m_fontIconChar));
 
     return pixmap;
@@ -601,114 +674,8 @@ QPixmap QWinUIIcon::renderFontIcon() const
 
 QChar QWinUIIcon::getFluentIconChar(const QString& iconName) const
 {
-    // Segoe Fluent Icons 字符映射表
-    static QHash<QString, QChar> fluentIconMap = {
-        // 常用图标
-        {"home", QChar(0xE80F)},
-        {"settings", QChar(0xE713)},
-        {"search", QChar(0xE721)},
-        {"add", QChar(0xE710)},
-        {"remove", QChar(0xE738)},
-        {"delete", QChar(0xE74D)},
-        {"edit", QChar(0xE70F)},
-        {"save", QChar(0xE74E)},
-        {"open", QChar(0xE8E5)},
-        {"close", QChar(0xE8BB)},
-        {"back", QChar(0xE72B)},
-        {"forward", QChar(0xE72A)},
-        {"refresh", QChar(0xE72C)},
-        {"download", QChar(0xE896)},
-        {"upload", QChar(0xE898)},
-        {"copy", QChar(0xE8C8)},
-        {"paste", QChar(0xE77F)},
-        {"cut", QChar(0xE8C6)},
-        {"undo", QChar(0xE7A7)},
-        {"redo", QChar(0xE7A6)},
-        {"play", QChar(0xE768)},
-        {"pause", QChar(0xE769)},
-        {"stop", QChar(0xE71A)},
-        {"volume", QChar(0xE767)},
-        {"mute", QChar(0xE74F)},
-        {"favorite", QChar(0xE734)},
-        {"heart", QChar(0xE734)},
-        {"star", QChar(0xE735)},
-        {"bookmark", QChar(0xE8A4)},
-        {"folder", QChar(0xE8B7)},
-        {"file", QChar(0xE8A5)},
-        {"document", QChar(0xE8A5)},
-        {"mail", QChar(0xE715)},
-        {"message", QChar(0xE8BD)},
-        {"phone", QChar(0xE717)},
-        {"contact", QChar(0xE77B)},
-        {"calendar", QChar(0xE787)},
-        {"clock", QChar(0xE823)},
-        {"camera", QChar(0xE722)},
-        {"picture", QChar(0xE91B)},
-        {"video", QChar(0xE714)},
-        {"music", QChar(0xE8D6)},
-        {"microphone", QChar(0xE720)},
-        {"speaker", QChar(0xE7F5)},
-        {"wifi", QChar(0xE701)},
-        {"bluetooth", QChar(0xE702)},
-        {"battery", QChar(0xE83F)},
-        {"power", QChar(0xE7E8)},
-        {"lock", QChar(0xE72E)},
-        {"unlock", QChar(0xE785)},
-        {"user", QChar(0xE77B)},
-        {"people", QChar(0xE716)},
-        {"globe", QChar(0xE774)},
-        {"location", QChar(0xE81D)},
-        {"map", QChar(0xE707)},
-        {"car", QChar(0xE804)},
-        {"airplane", QChar(0xE709)},
-        {"train", QChar(0xE7C0)},
-        {"shopping", QChar(0xE7BF)},
-        {"cart", QChar(0xE7BF)},
-        {"money", QChar(0xE8D4)},
-        {"calculator", QChar(0xE8EF)},
-        {"keyboard", QChar(0xE765)},
-        {"mouse", QChar(0xE962)},
-        {"print", QChar(0xE749)},
-        {"scan", QChar(0xE8FE)},
-        {"share", QChar(0xE72D)},
-        {"link", QChar(0xE71B)},
-        {"attach", QChar(0xE723)},
-        {"flag", QChar(0xE7C1)},
-        {"tag", QChar(0xE8EC)},
-        {"filter", QChar(0xE71C)},
-        {"sort", QChar(0xE8CB)},
-        {"view", QChar(0xE890)},
-        {"list", QChar(0xE8FD)},
-        {"grid", QChar(0xE80A)},
-        {"zoom_in", QChar(0xE8A3)},
-        {"zoom_out", QChar(0xE71F)},
-        {"full_screen", QChar(0xE740)},
-        {"minimize", QChar(0xE921)},
-        {"maximize", QChar(0xE922)},
-        {"restore", QChar(0xE923)},
-        {"help", QChar(0xE897)},
-        {"info", QChar(0xE946)},
-        {"warning", QChar(0xE7BA)},
-        {"error", QChar(0xE783)},
-        {"success", QChar(0xE73E)},
-        {"check", QChar(0xE73E)},
-        {"cancel", QChar(0xE711)},
-        {"clear", QChar(0xE894)},
-        {"more", QChar(0xE712)},
-        {"menu", QChar(0xE700)},
-        {"hamburger", QChar(0xE700)},
-        {"dots", QChar(0xE712)},
-        {"arrow_up", QChar(0xE70E)},
-        {"arrow_down", QChar(0xE70D)},
-        {"arrow_left", QChar(0xE70C)},
-        {"arrow_right", QChar(0xE70B)},
-        {"chevron_up", QChar(0xE70E)},
-        {"chevron_down", QChar(0xE70D)},
-        {"chevron_left", QChar(0xE76B)},
-        {"chevron_right", QChar(0xE76C)}
-    };
-
-    return fluentIconMap.value(iconName.toLower(), QChar());
+    // Segoe Fluent Icons 字符映射表在编译期生成
+    return QWinUIFluentIcons::Utils::getIconChar(iconName);
 }
 
 void QWinUIIcon::updateThemeColor()
@@ -747,6 +714,13 @@ QColor QWinUIIcon::getEffectiveIconColor() const
     return color;
 }
 
+bool QWinUIIcon::isTransformed() const
+{
+    return !qFuzzyIsNull(m_rotation)
+        || m_rotationAnimation->state() == QPropertyAnimation::Running
+        || m_spinAnimation->state() == QPropertyAnimation::Running;
+}
+
 QTransform QWinUIIcon::getTransform() const
 {
     QTransform transform;
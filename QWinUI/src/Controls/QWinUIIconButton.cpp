@@ -265,12 +265,7 @@ void QWinUIIconButton::paintEvent(QPaintEvent* event)
 
 QPixmap QWinUIIconButton::colorizePixmap(const QPixmap& pixmap, const QColor& color) const
 {
-    QPixmap colorizedPixmap = pixmap;
-    QPainter painter(&colorizedPixmap);
-    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
-    painter.fillRect(colorizedPixmap.rect(), color);
-    painter.end();
-    return colorizedPixmap;
+    return QWinUIIconManager::colorizePixmap(pixmap, color);
 }
 
 QIcon QWinUIIconButton::createFluentIcon(const QChar& iconChar) const
@@ -279,6 +274,39 @@ QIcon QWinUIIconButton::createFluentIcon(const QChar& iconChar) const
         return QIcon();
     }
 
+    // 尝试使用多个可能的字体名称（只解析一次，各尺寸共用）
+    const QStringList fontNames = {
+        "Segoe Fluent Icons",
+        "Segoe MDL2 Assets",
+        "Segoe UI Symbol",
+        "Segoe UI Emoji",
+        "Arial Unicode MS"
+    };
+
+    const QStringList families = QFontDatabase::families();
+    QString fontFamily = fontNames.last();
+    for (const QString& fontName : fontNames) {
+        // 检查字体是否真的可用
+        if (families.contains(fontName, Qt::CaseInsensitive)) {
+            fontFamily = fontName;
+            break;
+        }
+    }
+
+    // 设置颜色 - 支持主题联动
+    QColor textColor;
+    if (m_colorizeIcon) {
+        textColor = m_iconColor;
+    } else {
+        // 根据主题自动选择颜色
+        QWinUITheme* theme = QWinUITheme::getInstance();
+        if (theme && theme->isDarkMode()) {
+            textColor = QColor(255, 255, 255, 200); // 深色主题用浅色图标
+        } else {
+            textColor = QColor(0, 0, 0, 180); // 浅色主题用深色图标
+        }
+    }
+
     // 创建不同大小的图标
     QIcon icon;
     QList<int> sizes = {16, 24, 32, 48, 64};
@@ -291,55 +319,27 @@ QIcon QWinUIIconButton::createFluentIcon(const QChar& iconChar) const
         painter.setRenderHint(QPainter::Antialiasing);
         painter.setRenderHint(QPainter::TextAntialiasing);
 
-        // 尝试使用多个可能的字体名称
-        QStringList fontNames = {
-            "Segoe Fluent Icons",
-            "Segoe MDL2 Assets",
-            "Segoe UI Symbol",
-            "Segoe UI Emoji",
-            "Arial Unicode MS"
-        };
-
-        QFont font;
-        QString usedFontName = "Unknown";
-
-        for (const QString& fontName : fontNames) {
-            font = QFont(fontName, size * 0.6); // 稍微小一点
-            QFontInfo fontInfo(font);
-            usedFontName = fontInfo.family();
-
-            // 检查字体是否真的可用
-            if (QFontDatabase::families().contains(fontName, Qt::CaseInsensitive)) {
-                break;
-            }
-        }
-
         // 确保字体大小合适
         int pixelSize = qMax(8, static_cast<int>(size * 0.6)); // 确保最小8像素
-        font.setPixelSize(pixelSize);
-        font.setStyleStrategy(QFont::PreferAntialias);
-
-        painter.setFont(font);
 
-        // 设置颜色 - 支持主题联动
-        QColor textColor;
-        if (m_colorizeIcon) {
-            textColor = m_iconColor;
+        // 优先填充缓存的字形轮廓，工具栏中的大量字形图标共用同一份轮廓
+        const QPainterPath glyphPath = QWinUIIconManager::getInstance()->getGlyphPath(fontFamily, iconChar, pixelSize);
+        if (!glyphPath.isEmpty()) {
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(textColor);
+            painter.translate(QRectF(0, 0, size, size).center());
+            painter.drawPath(glyphPath);
         } else {
-            // 根据主题自动选择颜色
-            QWinUITheme* theme = QWinUITheme::getInstance();
-            if (theme && theme->isDarkMode()) {
-                textColor = QColor(255, 255, 255, 200); // 深色主题用浅色图标
-            } else {
-                textColor = QColor(0, 0, 0, 180); // 浅色主题用深色图标
-            }
+            QFont font(fontFamily);
+            font.setPixelSize(pixelSize);
+            font.setStyleStrategy(QFont::PreferAntialias);
+            painter.setFont(font);
+            painter.setPen(textColor);
+
+            // 绘制图标字符
+            QRect textRect(0, 0, size, size);
+            painter.drawText(textRect, Qt::AlignCenter, QString(iconChar));
         }
-        painter.setPen(textColor);
-
-        // 绘制图标字符
-        QRect textRect(0, 0, size, size);
-        QString iconText = QString(iconChar);
-        painter.drawText(textRect, Qt::AlignCenter, iconText);
 
         icon.addPixmap(pixmap);
     }
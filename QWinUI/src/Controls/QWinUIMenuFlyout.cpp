@@ -531,12 +531,6 @@ QWinUIMenuFlyout::QWinUIMenuFlyout(QWidget* parent)
 
 QWinUIMenuFlyout::~QWinUIMenuFlyout()
 {
-    // 断开主题连接，避免悬空指针
-    QWinUITheme* theme = QWinUITheme::getInstance();
-    if (theme) {
-        disconnect(theme, &QWinUITheme::themeChanged, this, &QWinUIMenuFlyout::onThemeChanged);
-    }
-
     // 移除事件过滤器
     // qApp->removeEventFilter(this);
 
@@ -601,12 +595,6 @@ void QWinUIMenuFlyout::initializeMenuFlyout()
     // 初始化颜色
     updateColors();
 
-    // 连接主题变化信号
-    QWinUITheme* theme = QWinUITheme::getInstance();
-    if (theme) {
-        connect(theme, &QWinUITheme::themeChanged, this, &QWinUIMenuFlyout::onThemeChanged);
-    }
-
     // 暂时不安装全局事件过滤器，避免潜在的崩溃问题
     // qApp->installEventFilter(this);
 }
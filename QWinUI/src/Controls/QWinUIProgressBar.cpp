@@ -1,5 +1,6 @@
 #include "../../include/QWinUI/Controls/QWinUIProgressBar.h"
 #include "../../include/QWinUI/QWinUITheme.h"
+#include "../../include/QWinUI/QWinUIFrameClock.h"
 #include <QPainter>
 #include <QFontMetrics>
 #include <QPainterPath>
@@ -24,9 +25,9 @@ QWinUIProgressBar::QWinUIProgressBar(QWidget* parent)
     , m_autoToolTip(true)
     , m_animationDuration(DefaultAnimationDuration)
     , m_valueAnimation(nullptr)
-    , m_indeterminateTimer(nullptr)
     , m_animatedValue(0.0)
     , m_indeterminatePosition(0.0)
+    , m_indeterminateTime(0.0)
     , m_isFirstCycle(true)
 {
     initializeProgressBar();
@@ -37,9 +38,7 @@ QWinUIProgressBar::~QWinUIProgressBar()
     if (m_valueAnimation) {
         m_valueAnimation->stop();
     }
-    if (m_indeterminateTimer) {
-        m_indeterminateTimer->stop();
-    }
+    QWinUIFrameClock::getInstance()->unsubscribe(this);
 }
 
 void QWinUIProgressBar::initializeProgressBar()
@@ -56,11 +55,6 @@ void QWinUIProgressBar::initializeProgressBar()
     
     // 设置动画
     setupAnimations();
-    
-    // 连接主题变化
-    if (QWinUITheme* theme = QWinUITheme::getInstance()) {
-        connect(theme, &QWinUITheme::themeChanged, this, &QWinUIProgressBar::onThemeChanged);
-    }
 }
 
 void QWinUIProgressBar::setupAnimations()
@@ -71,12 +65,8 @@ void QWinUIProgressBar::setupAnimations()
     m_valueAnimation->setEasingCurve(QEasingCurve::OutCubic);
     connect(m_valueAnimation, &QPropertyAnimation::valueChanged, 
             this, &QWinUIProgressBar::onAnimationValueChanged);
-    
-    // 不确定状态动画定时器
-    m_indeterminateTimer = new QTimer(this);
-    m_indeterminateTimer->setInterval(16); // ~60 FPS
-    connect(m_indeterminateTimer, &QTimer::timeout, 
-            this, &QWinUIProgressBar::onIndeterminateAnimation);
+
+    // 不确定状态动画由共享帧时钟驱动，见 startIndeterminateAnimation()
 }
 
 double QWinUIProgressBar::value() const
@@ -333,17 +323,28 @@ void QWinUIProgressBar::resizeEvent(QResizeEvent* event)
     update();
 }
 
+void QWinUIProgressBar::showEvent(QShowEvent* event)
+{
+    QWinUIWidget::showEvent(event);
+
+    if (m_isIndeterminate && !QWinUIFrameClock::getInstance()->isSubscribed(this)) {
+        resumeIndeterminateAnimation();
+    }
+}
+
 void QWinUIProgressBar::onAnimationValueChanged(const QVariant& value)
 {
     m_animatedValue = value.toDouble();
     update();
 }
 
-void QWinUIProgressBar::onIndeterminateAnimation()
+void QWinUIProgressBar::onIndeterminateAnimation(qint64 deltaMs)
 {
     // 使用平滑的速度变化，避免卡顿
-    static double animationTime = 0.0;
-    animationTime += 0.016; // 约 60 FPS
+    // 速度常量以 60 FPS 的一帧为单位，按实际经过的时间缩放
+    double frameScale = deltaMs / 16.0;
+    m_indeterminateTime += deltaMs / 1000.0;
+    double animationTime = m_indeterminateTime;
 
     // 基础速度
     double baseSpeed;
@@ -361,7 +362,7 @@ void QWinUIProgressBar::onIndeterminateAnimation()
         speedMultiplier = qMax(0.3, speedMultiplier);
     }
 
-    double currentSpeed = baseSpeed * speedMultiplier;
+    double currentSpeed = baseSpeed * speedMultiplier * frameScale;
 
     // 更新不确定状态的位置
     m_indeterminatePosition += currentSpeed;
@@ -401,21 +402,26 @@ void QWinUIProgressBar::startValueAnimation(double targetValue)
 
 void QWinUIProgressBar::startIndeterminateAnimation()
 {
-    if (m_indeterminateTimer) {
-        m_indeterminatePosition = -IndeterminateBlockMaxWidth;
+    m_indeterminatePosition = -IndeterminateBlockMaxWidth;
+    m_indeterminateTime = 0.0;
 
-        // 重置第一次循环标志，确保每次启动都有温和的开始
-        m_isFirstCycle = true;
+    // 重置第一次循环标志，确保每次启动都有温和的开始
+    m_isFirstCycle = true;
 
-        m_indeterminateTimer->start();
-    }
+    resumeIndeterminateAnimation();
+}
+
+void QWinUIProgressBar::resumeIndeterminateAnimation()
+{
+    // 不可见时帧时钟会自动移除订阅，重新显示时在 showEvent 中恢复
+    QWinUIFrameClock::getInstance()->subscribe(this, [this](qint64 deltaMs) {
+        onIndeterminateAnimation(deltaMs);
+    });
 }
 
 void QWinUIProgressBar::stopIndeterminateAnimation()
 {
-    if (m_indeterminateTimer) {
-        m_indeterminateTimer->stop();
-    }
+    QWinUIFrameClock::getInstance()->unsubscribe(this);
     m_indeterminatePosition = 0.0;
 }
 
@@ -1,10 +1,11 @@
 #include "QWinUI/Controls/QWinUIProgressRing.h"
 #include "QWinUI/QWinUITheme.h"
+#include "QWinUI/QWinUIFrameClock.h"
 #include <QPainter>
 #include <QPainterPath>
 #include <QResizeEvent>
-#include <QDateTime>
 #include <QtMath>
+#include <cmath>
 #include <QDebug>
 
 QT_BEGIN_NAMESPACE
@@ -19,14 +20,12 @@ QWinUIProgressRing::QWinUIProgressRing(QWidget* parent)
     , m_ringThickness(DEFAULT_RING_THICKNESS)
     , m_useThemeColors(true)
     , m_valueAnimation(nullptr)
-    , m_indeterminateTimer(new QTimer(this))
     , m_animatedValue(DEFAULT_VALUE)
     , m_targetValue(DEFAULT_VALUE)
     , m_indeterminateAngle(0.0)
     , m_indeterminateSpan(INDETERMINATE_MIN_SPAN)
     , m_indeterminateDirection(true)
     , m_indeterminatePhase(0.0)
-    , m_lastUpdateTime(0)
     , m_animationPaused(false)
 {
     initializeComponent();
@@ -37,7 +36,7 @@ QWinUIProgressRing::~QWinUIProgressRing()
     if (m_valueAnimation) {
         m_valueAnimation->stop();
     }
-    m_indeterminateTimer->stop();
+    QWinUIFrameClock::getInstance()->unsubscribe(this);
 }
 
 void QWinUIProgressRing::initializeComponent()
@@ -49,10 +48,6 @@ void QWinUIProgressRing::initializeComponent()
     // 初始化颜色
     updateColors();
     
-    // 设置不确定动画定时器
-    m_indeterminateTimer->setInterval(INDETERMINATE_TIMER_INTERVAL);
-    connect(m_indeterminateTimer, &QTimer::timeout, this, &QWinUIProgressRing::updateIndeterminateAnimation);
-    
     // 创建值动画 - 使用自定义属性以获得更好的控制
     m_valueAnimation = new QPropertyAnimation(this, "animatedValue", this);
     m_valueAnimation->setDuration(VALUE_ANIMATION_DURATION);
@@ -345,21 +340,21 @@ void QWinUIProgressRing::onThemeChanged()
     QWinUIWidget::onThemeChanged();
 }
 
-void QWinUIProgressRing::updateIndeterminateAnimation()
+QWinUITheme::ColorTokenSet QWinUIProgressRing::themeColorTokens() const
 {
-    if (m_animationPaused || !isVisible()) {
-        return; // 不可见时暂停动画以节省资源
-    }
+    // 圆环使用强调色，背景圆环按深浅模式取值
+    return QWinUITheme::accentColorTokens()
+           | QWinUITheme::colorTokenSet({ QWinUITheme::ColorToken::ControlStrokeColorSecondary });
+}
 
-    // 计算时间差以确保帧率无关的动画
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    if (m_lastUpdateTime == 0) {
-        m_lastUpdateTime = currentTime;
+void QWinUIProgressRing::updateIndeterminateAnimation(qint64 deltaMs)
+{
+    if (m_animationPaused) {
         return;
     }
 
-    double deltaTime = (currentTime - m_lastUpdateTime) / 1000.0; // 转换为秒
-    m_lastUpdateTime = currentTime;
+    // 按帧时钟给出的时间差推进，动画速度与帧率和事件循环负载无关
+    double deltaTime = deltaMs / 1000.0; // 转换为秒
 
     // 更新动画相位 - 加快呼吸效果
     m_indeterminatePhase += deltaTime * 4.0; // 4弧度/秒的基础速度 - 加快
@@ -368,9 +363,9 @@ void QWinUIProgressRing::updateIndeterminateAnimation()
     }
 
     // 平滑的旋转动画 - 更快的旋转
-    m_indeterminateAngle += INDETERMINATE_ROTATION_SPEED;
+    m_indeterminateAngle += INDETERMINATE_ROTATION_SPEED * deltaTime;
     if (m_indeterminateAngle >= 360.0) {
-        m_indeterminateAngle -= 360.0;
+        m_indeterminateAngle = std::fmod(m_indeterminateAngle, 360.0);
     }
 
     // 更自然的呼吸效果 - 使用正弦波，更快的变化
@@ -388,21 +383,20 @@ void QWinUIProgressRing::onValueAnimationFinished()
 
 void QWinUIProgressRing::startIndeterminateAnimation()
 {
-    if (!m_indeterminateTimer->isActive() && isVisible()) {
+    QWinUIFrameClock* clock = QWinUIFrameClock::getInstance();
+    if (!clock->isSubscribed(this) && isVisible()) {
         m_indeterminateAngle = 0.0;
         m_indeterminateSpan = INDETERMINATE_MIN_SPAN;
         m_indeterminatePhase = 0.0;
-        m_lastUpdateTime = 0;
         m_animationPaused = false;
-        m_indeterminateTimer->start();
+        clock->subscribe(this, [this](qint64 deltaMs) { updateIndeterminateAnimation(deltaMs); });
     }
 }
 
 void QWinUIProgressRing::stopIndeterminateAnimation()
 {
-    m_indeterminateTimer->stop();
+    QWinUIFrameClock::getInstance()->unsubscribe(this);
     m_animationPaused = true;
-    m_lastUpdateTime = 0;
 }
 
 void QWinUIProgressRing::startValueAnimation(double targetValue)
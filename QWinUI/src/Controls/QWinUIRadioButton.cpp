@@ -60,12 +60,6 @@ void QWinUIRadioButton::initializeRadioButton()
     
     // 设置动画
     setupAnimations();
-    
-    // 连接主题变化信号
-    QWinUITheme* theme = QWinUITheme::getInstance();
-    if (theme) {
-        connect(theme, &QWinUITheme::themeChanged, this, &QWinUIRadioButton::onThemeChanged);
-    }
 }
 
 void QWinUIRadioButton::setupAnimations()
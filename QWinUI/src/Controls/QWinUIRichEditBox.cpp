@@ -74,12 +74,6 @@ void QWinUIRichEditBox::initializeComponent()
 
     // 安装事件过滤器来监听QWinUITextInput的焦点事件
     m_textInput->installEventFilter(this);
-
-    // 连接主题变化信号
-    auto theme = QWinUITheme::getInstance();
-    if (theme) {
-        connect(theme, &QWinUITheme::themeChanged, this, &QWinUIRichEditBox::updateColors);
-    }
 }
 
 void QWinUIRichEditBox::updateColors()
@@ -154,7 +148,7 @@ void QWinUIRichEditBox::updateColors()
 // 事件处理
 void QWinUIRichEditBox::paintEvent(QPaintEvent* event)
 {
-    // 首先调用父类的paintEvent来处理主题切换动画
+    // 首先调用父类的paintEvent绘制基础背景
     QWinUIWidget::paintEvent(event);
 
     QPainter painter(this);
@@ -162,12 +156,7 @@ void QWinUIRichEditBox::paintEvent(QPaintEvent* event)
 
     QRect rect = this->rect();
 
-    // 只有在没有主题切换动画时才绘制背景
-    if (!isThemeTransitioning()) {
-        painter.fillRect(rect, m_backgroundColor);
-    } else {
-        // 在主题切换动画期间，QWinUITextInput 会自动处理背景
-    }
+    painter.fillRect(rect, m_backgroundColor);
 
     // 绘制完整的圆角边框
     QColor borderColor = m_borderColor;
@@ -1,5 +1,6 @@
 #include "QWinUI/Controls/QWinUIScrollBar.h"
 #include "QWinUI/QWinUITheme.h"
+#include "QWinUI/QWinUIFrameClock.h"
 #include <QPainter>
 #include <QPainterPath>
 #include <QMouseEvent>
@@ -26,8 +27,13 @@ QWinUIScrollBar::QWinUIScrollBar(Qt::Orientation orientation, QWidget* parent)
     , m_trackWidth(6)
     , m_opacity(1.0)
     , m_autoHide(false)
-    , m_autoHideTimer(nullptr)
-    , m_fadeAnimation(nullptr)
+    , m_autoHidePending(false)
+    , m_idleTime(0)
+    , m_fading(false)
+    , m_fadeStartOpacity(1.0)
+    , m_fadeTargetOpacity(1.0)
+    , m_fadeElapsed(0)
+    , m_fadeEasing(QEasingCurve::OutQuart)
     , m_sliderDown(false)
     , m_thumbHovered(false)
     , m_trackHovered(false)
@@ -39,14 +45,7 @@ QWinUIScrollBar::QWinUIScrollBar(Qt::Orientation orientation, QWidget* parent)
 
 QWinUIScrollBar::~QWinUIScrollBar()
 {
-    if (m_fadeAnimation) {
-        m_fadeAnimation->stop();
-        delete m_fadeAnimation;
-    }
-    
-    if (m_autoHideTimer) {
-        delete m_autoHideTimer;
-    }
+    QWinUIFrameClock::getInstance()->unsubscribe(this);
 }
 
 void QWinUIScrollBar::initializeScrollBar()
@@ -65,18 +64,8 @@ void QWinUIScrollBar::initializeScrollBar()
         setFixedWidth(m_trackWidth);
     }
     
-    // 创建自动隐藏定时器
-    m_autoHideTimer = new QTimer(this);
-    m_autoHideTimer->setSingleShot(true);
-    m_autoHideTimer->setInterval(1500); // 1.5秒后自动隐藏
-    connect(m_autoHideTimer, &QTimer::timeout, this, &QWinUIScrollBar::onAutoHideTimer);
-    
-    // 创建淡入淡出动画
-    m_fadeAnimation = new QPropertyAnimation(this, "opacity");
-    m_fadeAnimation->setDuration(150);
-    m_fadeAnimation->setEasingCurve(QEasingCurve::OutQuart);
-    connect(m_fadeAnimation, &QPropertyAnimation::finished, this, &QWinUIScrollBar::onFadeAnimationFinished);
-    
+    // 自动隐藏计时和淡入淡出动画由共享帧时钟驱动，见 onFrame()
+
     // 设置圆角
     setCornerRadius(static_cast<int>(QWinUICornerRadius::Small));
 }
@@ -287,9 +276,10 @@ void QWinUIScrollBar::setAutoHide(bool autoHide)
         m_autoHide = autoHide;
         
         if (autoHide) {
-            m_autoHideTimer->start();
+            restartAutoHide();
         } else {
-            m_autoHideTimer->stop();
+            stopAutoHide();
+            m_fading = false;
             setOpacity(1.0);
         }
         
@@ -372,21 +362,61 @@ void QWinUIScrollBar::updateGeometry()
 
 void QWinUIScrollBar::startFadeAnimation(double targetOpacity)
 {
-    if (m_fadeAnimation->state() == QPropertyAnimation::Running) {
-        m_fadeAnimation->stop();
+    m_fadeStartOpacity = m_opacity;
+    m_fadeTargetOpacity = targetOpacity;
+    m_fadeElapsed = 0;
+    m_fading = true;
+    ensureFrameSubscription();
+}
+
+void QWinUIScrollBar::restartAutoHide()
+{
+    m_idleTime = 0;
+    m_autoHidePending = true;
+    ensureFrameSubscription();
+}
+
+void QWinUIScrollBar::stopAutoHide()
+{
+    m_autoHidePending = false;
+}
+
+void QWinUIScrollBar::ensureFrameSubscription()
+{
+    QWinUIFrameClock* clock = QWinUIFrameClock::getInstance();
+    if (!clock->isSubscribed(this)) {
+        clock->subscribe(this, [this](qint64 deltaMs) { onFrame(deltaMs); });
     }
-    
-    m_fadeAnimation->setStartValue(m_opacity);
-    m_fadeAnimation->setEndValue(targetOpacity);
-    m_fadeAnimation->start();
 }
 
-void QWinUIScrollBar::onFadeAnimationFinished()
+void QWinUIScrollBar::onFrame(qint64 deltaMs)
 {
-    // 动画完成处理
+    // 淡入淡出：按经过的时间计算透明度
+    if (m_fading) {
+        m_fadeElapsed += deltaMs;
+        double progress = qMin(1.0, double(m_fadeElapsed) / FADE_DURATION);
+        double eased = m_fadeEasing.valueForProgress(progress);
+        setOpacity(m_fadeStartOpacity + (m_fadeTargetOpacity - m_fadeStartOpacity) * eased);
+        if (progress >= 1.0) {
+            m_fading = false;
+        }
+    }
+
+    // 自动隐藏：空闲时间达到延迟后淡出
+    if (m_autoHidePending) {
+        m_idleTime += deltaMs;
+        if (m_idleTime >= AUTO_HIDE_DELAY) {
+            m_autoHidePending = false;
+            onAutoHideTimeout();
+        }
+    }
+
+    if (!m_fading && !m_autoHidePending) {
+        QWinUIFrameClock::getInstance()->unsubscribe(this);
+    }
 }
 
-void QWinUIScrollBar::onAutoHideTimer()
+void QWinUIScrollBar::onAutoHideTimeout()
 {
     if (m_autoHide && !m_thumbHovered && !m_sliderDown) {
         fadeOut();
@@ -579,7 +609,7 @@ void QWinUIScrollBar::mousePressEvent(QMouseEvent* event)
 
     // 重置自动隐藏定时器
     if (m_autoHide) {
-        m_autoHideTimer->start();
+        restartAutoHide();
     }
 
     QWinUIWidget::mousePressEvent(event);
@@ -648,7 +678,7 @@ void QWinUIScrollBar::wheelEvent(QWheelEvent* event)
 
     // 重置自动隐藏定时器
     if (m_autoHide) {
-        m_autoHideTimer->start();
+        restartAutoHide();
     }
 
     event->accept();
@@ -661,7 +691,7 @@ void QWinUIScrollBar::enterEvent(QEnterEvent* event)
 
     // 如果启用自动隐藏，显示滚动条
     if (m_autoHide) {
-        m_autoHideTimer->stop();
+        stopAutoHide();
         fadeIn();
     }
 
@@ -676,7 +706,7 @@ void QWinUIScrollBar::leaveEvent(QEvent* event)
 
     // 如果启用自动隐藏，开始隐藏定时器
     if (m_autoHide && !m_sliderDown) {
-        m_autoHideTimer->start();
+        restartAutoHide();
     }
 
     QWinUIWidget::leaveEvent(event);
@@ -737,6 +767,16 @@ void QWinUIScrollBar::resizeEvent(QResizeEvent* event)
     QWinUIWidget::resizeEvent(event);
 }
 
+void QWinUIScrollBar::showEvent(QShowEvent* event)
+{
+    QWinUIWidget::showEvent(event);
+
+    // 隐藏期间帧时钟会移除订阅，重新显示时继续未完成的动画
+    if (m_fading || m_autoHidePending) {
+        ensureFrameSubscription();
+    }
+}
+
 void QWinUIScrollBar::contextMenuEvent(QContextMenuEvent* event)
 {
     // 默认不显示上下文菜单
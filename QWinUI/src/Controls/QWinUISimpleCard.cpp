@@ -149,7 +149,7 @@ QSize QWinUISimpleCard::minimumSizeHint() const
 // 事件处理
 void QWinUISimpleCard::paintEvent(QPaintEvent* event)
 {
-    // 首先调用父类的paintEvent来处理主题切换动画
+    // 首先调用父类的paintEvent绘制基础背景
     QWinUIWidget::paintEvent(event);
 
     QPainter painter(this);
@@ -157,14 +157,11 @@ void QWinUISimpleCard::paintEvent(QPaintEvent* event)
 
     QRect cardRect = rect();
 
-    // 只有在没有主题切换动画时才绘制背景
-    if (!isThemeTransitioning()) {
-        // 绘制背景
-        drawBackground(&painter, cardRect);
+    // 绘制背景
+    drawBackground(&painter, cardRect);
 
-        // 绘制边框
-        drawBorder(&painter, cardRect);
-    }
+    // 绘制边框
+    drawBorder(&painter, cardRect);
 }
 
 void QWinUISimpleCard::showEvent(QShowEvent* event)
@@ -102,12 +102,6 @@ void QWinUISlider::initializeSlider()
     m_tooltipTimer->setInterval(500); // 500ms 延迟显示工具提示
     connect(m_tooltipTimer, &QTimer::timeout, this, &QWinUISlider::updateValueTooltip);
 
-    // 连接主题变化信号
-    QWinUITheme* theme = QWinUITheme::getInstance();
-    if (theme) {
-        connect(theme, &QWinUITheme::themeChanged, this, &QWinUISlider::onThemeChanged);
-    }
-
     // 初始化动画值
     m_animatedValue = m_value;
 }
@@ -95,34 +95,6 @@ void QWinUISplitButton::initializeButton()
     // 连接按下和释放信号以实现动画
     connect(m_dropDownButton, &QWinUIButton::pressed, this, &QWinUISplitButton::onDropDownButtonPressed);
     connect(m_dropDownButton, &QWinUIButton::released, this, &QWinUISplitButton::onDropDownButtonReleased);
-
-    // 连接主题变化信号
-    QWinUITheme* theme = QWinUITheme::getInstance();
-    if (theme) {
-        connect(theme, &QWinUITheme::themeChanged, this, [this]() {
-            // 主题变化时更新按钮样式
-            if (m_mainButton) {
-                m_mainButton->update();
-            }
-            if (m_dropDownButton) {
-                m_dropDownButton->update();
-            }
-            update(); // 更新自身
-        });
-
-        // 连接颜色变化信号
-        connect(theme, &QWinUITheme::colorChanged, this, [this](const QString& colorName, const QColor& color) {
-            Q_UNUSED(colorName)
-            Q_UNUSED(color)
-            // 颜色变化时更新按钮
-            if (m_mainButton) {
-                m_mainButton->update();
-            }
-            if (m_dropDownButton) {
-                m_dropDownButton->update();
-            }
-        });
-    }
 }
 
 void QWinUISplitButton::setText(const QString& text)
@@ -1,6 +1,7 @@
 #include "QWinUI/Controls/QWinUITextInput.h"
 #include "QWinUI/Controls/QWinUIRichEditBox.h"
 #include "QWinUI/QWinUITheme.h"
+#include "QWinUI/QWinUIFrameClock.h"
 #include <QPainter>
 #include <QKeyEvent>
 #include <QMouseEvent>
@@ -67,7 +68,6 @@ QWinUITextInput::QWinUITextInput(QWidget* parent)
     , m_selectionStart(-1)
     , m_selectionEnd(-1)
     , m_cursorVisible(true)
-    , m_cursorTimer(nullptr)
     , m_readOnly(false)
     , m_multiLine(false)
     , m_richTextEnabled(false)
@@ -77,29 +77,16 @@ QWinUITextInput::QWinUITextInput(QWidget* parent)
     , m_layoutDirty(true)
     , m_horizontalOffset(0)
     , m_cursorOpacity(1.0)
-    , m_cursorAnimation(nullptr)
-    , m_cursorVisibilityTimer(nullptr)
-    , m_isTyping(false)
+    , m_cursorPhaseTime(0)
+    , m_cursorEasing(QEasingCurve::InOutQuad)
+    , m_cursorHoldTimer(nullptr)
 {
     initializeTextInput();
 }
 
 QWinUITextInput::~QWinUITextInput()
 {
-    if (m_cursorTimer) {
-        m_cursorTimer->stop();
-        delete m_cursorTimer;
-    }
-
-    if (m_cursorAnimation) {
-        m_cursorAnimation->stop();
-        delete m_cursorAnimation;
-    }
-
-    if (m_cursorVisibilityTimer) {
-        m_cursorVisibilityTimer->stop();
-        delete m_cursorVisibilityTimer;
-    }
+    QWinUIFrameClock::getInstance()->unsubscribe(this);
 
     if (m_undoStack) {
         delete m_undoStack;
@@ -112,21 +99,17 @@ void QWinUITextInput::initializeTextInput()
     setFocusPolicy(Qt::StrongFocus);
     setAttribute(Qt::WA_InputMethodEnabled, true);
     
-    // 初始化光标动画系统
-    initializeCursorAnimation();
-    
     // 初始化撤销栈
     m_undoStack = new QUndoStack(this);
+
+    // 光标完全可见期间没有变化，不占用帧时钟
+    m_cursorHoldTimer = new QTimer(this);
+    m_cursorHoldTimer->setSingleShot(true);
+    connect(m_cursorHoldTimer, &QTimer::timeout, this, &QWinUITextInput::resumeCursorFrames);
     
     // 初始化颜色
     updateColors();
 
-    // 连接主题变化信号
-    QWinUITheme* theme = QWinUITheme::getInstance();
-    if (theme) {
-        connect(theme, &QWinUITheme::themeChanged, this, &QWinUITextInput::updateColors);
-    }
-    
     // 设置默认尺寸
     setMinimumSize(100, 32);
     setMaximumHeight(32);  // 限制最大高度
@@ -367,44 +350,6 @@ QSize QWinUITextInput::minimumSizeHint() const
     }
 }
 
-void QWinUITextInput::onCursorBlink()
-{
-    // 保留原有的简单闪烁逻辑作为备用
-    if (hasFocus() && !m_readOnly && !m_cursorAnimation) {
-        m_cursorVisible = !m_cursorVisible;
-        update();
-    }
-}
-
-void QWinUITextInput::onCursorVisibilityTimeout()
-{
-    // 当动画完成时，检查是否需要重新开始循环
-    if (hasFocus() && !m_readOnly && !m_isTyping) {
-        if (m_cursorAnimation->state() == QPropertyAnimation::Stopped) {
-            // 如果刚完成淡出，开始淡入
-            if (m_cursorOpacity <= 0.1) {
-                m_cursorAnimation->setStartValue(0.0);
-                m_cursorAnimation->setEndValue(1.0);
-                m_cursorAnimation->start();
-            }
-            // 如果刚完成淡入，等待一段时间后开始淡出
-            else {
-                m_cursorVisibilityTimer->start();
-            }
-        }
-    }
-}
-
-void QWinUITextInput::startCursorFadeOut()
-{
-    if (hasFocus() && !m_readOnly && !m_isTyping) {
-        // 开始淡出动画
-        m_cursorAnimation->setStartValue(1.0);
-        m_cursorAnimation->setEndValue(0.0);
-        m_cursorAnimation->start();
-    }
-}
-
 void QWinUITextInput::updateColors()
 {
     QWinUITheme* theme = QWinUITheme::getInstance();
@@ -443,7 +388,7 @@ void QWinUITextInput::updateColors()
 
 void QWinUITextInput::paintEvent(QPaintEvent* event)
 {
-    // 首先调用父类的paintEvent来处理主题切换动画
+    // 首先调用父类的paintEvent绘制基础背景
     QWinUIWidget::paintEvent(event);
 
     QPainter painter(this);
@@ -452,10 +397,9 @@ void QWinUITextInput::paintEvent(QPaintEvent* event)
 
     QRect rect = this->rect();
 
-    // 只有在没有主题切换动画时才绘制背景
     // 如果父控件是 QWinUIRichEditBox，则不绘制背景，让父控件处理
-    bool shouldDrawBackground = !isThemeTransitioning();
-    if (shouldDrawBackground && parent()) {
+    bool shouldDrawBackground = true;
+    if (parent()) {
         // 检查父控件是否是 QWinUIRichEditBox
         if (qobject_cast<QWinUIRichEditBox*>(parent())) {
             shouldDrawBackground = false;
@@ -916,6 +860,16 @@ void QWinUITextInput::onThemeChanged()
     updateColors();
 }
 
+QWinUITheme::ColorTokenSet QWinUITextInput::themeColorTokens() const
+{
+    // updateColors() 按深浅模式取值：文本、占位符、边框和输入区背景
+    using Token = QWinUITheme::ColorToken;
+    return QWinUITheme::colorTokenSet({ Token::TextFillColorPrimary,
+                                        Token::TextFillColorSecondary,
+                                        Token::ControlStrokeColorDefault,
+                                        Token::ControlFillColorInputActive });
+}
+
 // 编辑操作实现
 void QWinUITextInput::cut()
 {
@@ -1163,57 +1117,43 @@ void QWinUITextInput::ensureCursorVisible()
     m_horizontalOffset = qMax(0, m_horizontalOffset);
 }
 
-void QWinUITextInput::initializeCursorAnimation()
-{
-    // 初始化光标可见性定时器（控制光标显示1000ms）
-    m_cursorVisibilityTimer = new QTimer(this);
-    m_cursorVisibilityTimer->setSingleShot(true);
-    m_cursorVisibilityTimer->setInterval(CURSOR_VISIBLE_DURATION);
-    connect(m_cursorVisibilityTimer, &QTimer::timeout, this, &QWinUITextInput::startCursorFadeOut);
-
-    // 初始化光标透明度动画
-    m_cursorAnimation = new QPropertyAnimation(this, "cursorOpacity", this);
-    m_cursorAnimation->setDuration(CURSOR_FADE_DURATION);
-    m_cursorAnimation->setEasingCurve(QEasingCurve::InOutQuad);
-
-    // 连接动画完成信号
-    connect(m_cursorAnimation, &QPropertyAnimation::finished, this, &QWinUITextInput::onCursorVisibilityTimeout);
-
-    // 保留原有的定时器作为备用（兼容性）
-    m_cursorTimer = new QTimer(this);
-    m_cursorTimer->setInterval(CURSOR_BLINK_INTERVAL);
-    connect(m_cursorTimer, &QTimer::timeout, this, &QWinUITextInput::onCursorBlink);
-}
-
 void QWinUITextInput::startCursorAnimation()
 {
     if (m_readOnly) return;
 
-    // 停止所有现有动画
-    stopCursorAnimation();
-
-    // 设置光标为完全可见
-    m_cursorOpacity = 1.0;
+    // 设置光标为完全可见，并从可见阶段开始计时
+    m_cursorPhaseTime = 0;
     m_cursorVisible = true;
-    update();
+    holdCursorVisible(CURSOR_VISIBLE_DURATION);
+}
+
+void QWinUITextInput::holdCursorVisible(int durationMs)
+{
+    setCursorOpacity(1.0);
 
-    // 启动可见性定时器
-    m_cursorVisibilityTimer->start();
+    // 完全可见阶段透明度不变，退订帧时钟，只在淡出开始时恢复
+    QWinUIFrameClock::getInstance()->unsubscribe(this);
+    m_cursorHoldTimer->start(durationMs);
 }
 
-void QWinUITextInput::stopCursorAnimation()
+void QWinUITextInput::resumeCursorFrames()
 {
-    if (m_cursorAnimation) {
-        m_cursorAnimation->stop();
+    if (!hasFocus() || m_readOnly) {
+        return;
     }
 
-    if (m_cursorVisibilityTimer) {
-        m_cursorVisibilityTimer->stop();
+    // 淡入淡出由共享帧时钟驱动
+    m_cursorPhaseTime = CURSOR_VISIBLE_DURATION;
+    QWinUIFrameClock* clock = QWinUIFrameClock::getInstance();
+    if (!clock->isSubscribed(this)) {
+        clock->subscribe(this, [this](qint64 deltaMs) { onCursorFrame(deltaMs); });
     }
+}
 
-    if (m_cursorTimer) {
-        m_cursorTimer->stop();
-    }
+void QWinUITextInput::stopCursorAnimation()
+{
+    QWinUIFrameClock::getInstance()->unsubscribe(this);
+    m_cursorHoldTimer->stop();
 
     m_cursorVisible = false;
     m_cursorOpacity = 0.0;
@@ -1224,28 +1164,48 @@ void QWinUITextInput::resetCursorAnimation()
 {
     if (m_readOnly || !hasFocus()) return;
 
-    // 重置动画状态
-    m_isTyping = true;
+    // 输入时立即显示光标并重新开始完整可见阶段（模拟VSCode的行为）
+    startCursorAnimation();
+}
 
-    // 停止当前动画
-    if (m_cursorAnimation) {
-        m_cursorAnimation->stop();
+void QWinUITextInput::onCursorFrame(qint64 deltaMs)
+{
+    if (!hasFocus() || m_readOnly) {
+        stopCursorAnimation();
+        return;
     }
 
-    if (m_cursorVisibilityTimer) {
-        m_cursorVisibilityTimer->stop();
+    // 一个周期：完全可见 -> 淡出 -> 淡入
+    const qint64 cycle = CURSOR_VISIBLE_DURATION + CURSOR_FADE_DURATION * 2;
+    m_cursorPhaseTime = (m_cursorPhaseTime + deltaMs) % cycle;
+
+    // 淡入结束后进入下一个完全可见阶段
+    if (m_cursorPhaseTime < CURSOR_VISIBLE_DURATION) {
+        holdCursorVisible(int(CURSOR_VISIBLE_DURATION - m_cursorPhaseTime));
+        return;
     }
 
-    // 立即显示光标
-    m_cursorOpacity = 1.0;
-    m_cursorVisible = true;
-    update();
+    qreal opacity = 1.0;
+    if (m_cursorPhaseTime >= CURSOR_VISIBLE_DURATION + CURSOR_FADE_DURATION) {
+        // 淡入阶段
+        qreal t = qreal(m_cursorPhaseTime - CURSOR_VISIBLE_DURATION - CURSOR_FADE_DURATION) / CURSOR_FADE_DURATION;
+        opacity = m_cursorEasing.valueForProgress(t);
+    } else if (m_cursorPhaseTime >= CURSOR_VISIBLE_DURATION) {
+        // 淡出阶段
+        qreal t = qreal(m_cursorPhaseTime - CURSOR_VISIBLE_DURATION) / CURSOR_FADE_DURATION;
+        opacity = 1.0 - m_cursorEasing.valueForProgress(t);
+    }
 
-    // 延迟重新启动动画（模拟VSCode的行为）
-    QTimer::singleShot(100, this, [this]() {
-        m_isTyping = false;
-        if (hasFocus() && !m_readOnly) {
-            startCursorAnimation();
-        }
-    });
+    // setCursorOpacity 只在透明度实际变化时重绘
+    setCursorOpacity(opacity);
+}
+
+void QWinUITextInput::showEvent(QShowEvent* event)
+{
+    QWinUIWidget::showEvent(event);
+
+    // 隐藏期间帧时钟会移除订阅，重新显示时恢复光标动画
+    if (hasFocus() && !m_readOnly) {
+        startCursorAnimation();
+    }
 }
@@ -68,12 +68,6 @@ void QWinUIToggleButton::initializeToggleButton()
     
     // 设置初始文本
     updateButtonText();
-    
-    // 连接主题变化信号
-    QWinUITheme* theme = QWinUITheme::getInstance();
-    if (theme) {
-        connect(theme, &QWinUITheme::themeChanged, this, &QWinUIToggleButton::updateColors);
-    }
 }
 
 void QWinUIToggleButton::setupColorAnimations()
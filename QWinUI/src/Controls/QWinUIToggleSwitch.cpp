@@ -165,7 +165,7 @@ void QWinUIToggleSwitch::onThemeChanged()
 
 void QWinUIToggleSwitch::paintEvent(QPaintEvent* event)
 {
-    // 首先调用父类的paintEvent来处理主题切换动画
+    // 首先调用父类的paintEvent绘制基础背景
     QWinUIWidget::paintEvent(event);
 
     QPainter painter(this);
@@ -96,11 +96,6 @@ void QWinUIToolTip::initializeToolTip()
     // 设置动画
     setupAnimations();
     
-    // 连接主题变化
-    if (QWinUITheme* theme = QWinUITheme::getInstance()) {
-        connect(theme, &QWinUITheme::themeChanged, this, &QWinUIToolTip::onThemeChanged);
-    }
-
     // 初始隐藏
     hide();
 }
@@ -55,12 +55,6 @@ void QWinUIVariableSizedWrapGrid::initializeComponent()
     // 初始化颜色
     updateColors();
     
-    // 连接主题变化信号
-    QWinUITheme* theme = QWinUITheme::getInstance();
-    if (theme) {
-        connect(theme, &QWinUITheme::themeChanged, this, &QWinUIVariableSizedWrapGrid::updateColors);
-    }
-    
     // 设置默认尺寸
     setMinimumSize(200, 200);
 }
@@ -342,7 +336,7 @@ void QWinUIVariableSizedWrapGrid::resizeEvent(QResizeEvent* event)
 
 void QWinUIVariableSizedWrapGrid::paintEvent(QPaintEvent* event)
 {
-    // 调用父类的paintEvent来处理主题切换动画
+    // 调用父类的paintEvent绘制基础背景
     QWinUIWidget::paintEvent(event);
 
     QPainter painter(this);
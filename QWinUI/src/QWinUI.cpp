@@ -35,6 +35,7 @@ void initialize()
 void cleanup()
 {
     // 清理QWinUI库
+    QWinUIFrameClock::destroyInstance();
     QWinUITheme::destroyInstance();
 }
 
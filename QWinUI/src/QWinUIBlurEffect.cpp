@@ -1,4 +1,5 @@
 #include "QWinUI/QWinUIBlurEffect.h"
+#include "QWinUISoftwareBackdrop.h"
 #include <QWidget>
 #include <QDebug>
 
@@ -90,8 +91,19 @@ bool QWinUIBlurEffect::enableBlurBehindWindow(QWidget* widget, BlurType type)
         return enableAcrylicEffectWin10(hwnd, QColor(255, 255, 255, 200));
     }
 #else
-    Q_UNUSED(widget)
-    Q_UNUSED(type)
+    // 没有系统合成器支持，在窗口内容之下绘制软件实现的背景层
+    switch (type) {
+    case None:
+        return disableBlurBehindWindow(widget);
+    case Blur:
+        return QWinUISoftwareBackdrop::attach(widget, QWinUISoftwareBackdrop::Acrylic, QColor(Qt::transparent)) != nullptr;
+    case Acrylic:
+        return QWinUISoftwareBackdrop::attach(widget, QWinUISoftwareBackdrop::Acrylic, QColor(255, 255, 255, 200)) != nullptr;
+    case Mica:
+        return QWinUISoftwareBackdrop::attach(widget, QWinUISoftwareBackdrop::Mica, QColor()) != nullptr;
+    case MicaAlt:
+        return QWinUISoftwareBackdrop::attach(widget, QWinUISoftwareBackdrop::MicaAlt, QColor()) != nullptr;
+    }
 #endif
 
     return false;
@@ -112,10 +124,8 @@ bool QWinUIBlurEffect::disableBlurBehindWindow(QWidget* widget)
     WINDOWCOMPOSITIONATTRIBDATA data = { 19, &accent, sizeof(accent) };
     return SetWindowCompositionAttribute(hwnd, &data);
 #else
-    Q_UNUSED(widget)
+    return QWinUISoftwareBackdrop::detach(widget);
 #endif
-
-    return false;
 }
 
 bool QWinUIBlurEffect::setAcrylicEffect(QWidget* widget, const QColor& tintColor)
@@ -128,11 +138,8 @@ bool QWinUIBlurEffect::setAcrylicEffect(QWidget* widget, const QColor& tintColor
 
     return enableAcrylicEffectWin10(hwnd, tintColor);
 #else
-    Q_UNUSED(widget)
-    Q_UNUSED(tintColor)
+    return QWinUISoftwareBackdrop::attach(widget, QWinUISoftwareBackdrop::Acrylic, tintColor) != nullptr;
 #endif
-
-    return false;
 }
 
 bool QWinUIBlurEffect::setMicaEffect(QWidget* widget, bool isDark)
@@ -147,8 +154,11 @@ bool QWinUIBlurEffect::setMicaEffect(QWidget* widget, bool isDark)
         return enableMicaEffectWin11(hwnd, isDark);
     }
 #else
-    Q_UNUSED(widget)
-    Q_UNUSED(isDark)
+    QWinUISoftwareBackdrop* backdrop = QWinUISoftwareBackdrop::attach(widget, QWinUISoftwareBackdrop::Mica, QColor());
+    if (backdrop) {
+        backdrop->setDarkMode(isDark);
+        return true;
+    }
 #endif
 
     return false;
@@ -167,10 +177,12 @@ bool QWinUIBlurEffect::isBlurSupported(BlurType type)
     case MicaAlt:
         return isWindows11OrGreater();
     }
+    return false;
 #else
+    // 其他平台使用软件实现
     Q_UNUSED(type)
+    return true;
 #endif
-    return false;
 }
 
 bool QWinUIBlurEffect::isWindows10OrGreater()
@@ -0,0 +1,199 @@
+#include "QWinUI/QWinUIFrameClock.h"
+#include <QEvent>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QWindow>
+#include <QtMath>
+
+QT_BEGIN_NAMESPACE
+
+QWinUIFrameClock* QWinUIFrameClock::s_instance = nullptr;
+
+QWinUIFrameClock* QWinUIFrameClock::getInstance()
+{
+    if (!s_instance) {
+        s_instance = new QWinUIFrameClock();
+    }
+    return s_instance;
+}
+
+void QWinUIFrameClock::destroyInstance()
+{
+    if (s_instance) {
+        delete s_instance;
+        s_instance = nullptr;
+    }
+}
+
+QWinUIFrameClock::QWinUIFrameClock(QObject* parent)
+    : QObject(parent)
+    , m_lastFrameTime(0)
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setInterval(DEFAULT_FRAME_INTERVAL);
+    connect(&m_timer, &QTimer::timeout, this, &QWinUIFrameClock::onFrame);
+}
+
+QWinUIFrameClock::~QWinUIFrameClock()
+{
+    m_timer.stop();
+    m_subscribers.clear();
+}
+
+void QWinUIFrameClock::subscribe(QWidget* subscriber, FrameCallback callback)
+{
+    if (!subscriber || !callback) {
+        return;
+    }
+
+    Subscriber& entry = m_subscribers[subscriber];
+    entry.widget = subscriber;
+    entry.callback = std::move(callback);
+
+    if (!m_timer.isActive()) {
+        start();
+    }
+}
+
+void QWinUIFrameClock::unsubscribe(QWidget* subscriber)
+{
+    if (m_subscribers.remove(subscriber) && subscriber) {
+        subscriber->removeEventFilter(this);
+    }
+
+    if (m_subscribers.isEmpty()) {
+        stop();
+    }
+}
+
+bool QWinUIFrameClock::isSubscribed(const QWidget* subscriber) const
+{
+    return m_subscribers.contains(subscriber);
+}
+
+int QWinUIFrameClock::subscriberCount() const
+{
+    return m_subscribers.size();
+}
+
+bool QWinUIFrameClock::isRunning() const
+{
+    return m_timer.isActive();
+}
+
+int QWinUIFrameClock::frameInterval() const
+{
+    return m_timer.interval();
+}
+
+void QWinUIFrameClock::start()
+{
+    updateFrameInterval();
+    m_elapsed.start();
+    m_lastFrameTime = 0;
+    m_timer.start();
+    emit runningChanged(true);
+}
+
+void QWinUIFrameClock::stop()
+{
+    if (m_timer.isActive()) {
+        m_timer.stop();
+        emit runningChanged(false);
+    }
+}
+
+void QWinUIFrameClock::updateFrameInterval()
+{
+    // 按主屏幕刷新率对齐帧间隔
+    int interval = DEFAULT_FRAME_INTERVAL;
+    if (QScreen* screen = QGuiApplication::primaryScreen()) {
+        const qreal refreshRate = screen->refreshRate();
+        if (refreshRate >= 30.0) {
+            interval = qMax(1, qFloor(1000.0 / refreshRate));
+        }
+    }
+    m_timer.setInterval(interval);
+}
+
+bool QWinUIFrameClock::isSubscriberActive(const QWidget* widget)
+{
+    if (!widget || !widget->isVisible()) {
+        return false;
+    }
+
+    // 窗口最小化或被完全遮挡时不再推进动画
+    const QWindow* handle = widget->window()->windowHandle();
+    return !handle || handle->isExposed();
+}
+
+void QWinUIFrameClock::watchForResume(QWidget* widget)
+{
+    // 控件重新显示、窗口重新暴露时恢复；事件到达后即移除，仍不可见时下一帧重新安装
+    widget->installEventFilter(this);
+    if (QWindow* handle = widget->window()->windowHandle()) {
+        handle->installEventFilter(this);
+    }
+}
+
+bool QWinUIFrameClock::eventFilter(QObject* watched, QEvent* event)
+{
+    const QEvent::Type type = event->type();
+    if ((type == QEvent::Show && watched->isWidgetType())
+        || (type == QEvent::Expose && watched->isWindowType())) {
+        watched->removeEventFilter(this);
+        if (!m_timer.isActive() && !m_subscribers.isEmpty()) {
+            // 下一帧重新判断每个订阅者，仍不可见的重新暂停并等待
+            for (Subscriber& subscriber : m_subscribers) {
+                subscriber.paused = false;
+            }
+            start();
+        }
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void QWinUIFrameClock::onFrame()
+{
+    const qint64 now = m_elapsed.elapsed();
+    const qint64 delta = qBound<qint64>(0, now - m_lastFrameTime, MAX_FRAME_DELTA);
+    m_lastFrameTime = now;
+
+    // 回调中可能增删订阅者，先取出当前快照
+    const QList<const QWidget*> keys = m_subscribers.keys();
+    bool anyActive = false;
+    for (const QWidget* key : keys) {
+        auto it = m_subscribers.find(key);
+        if (it == m_subscribers.end()) {
+            continue;
+        }
+
+        if (!it->widget) {
+            // 控件已销毁
+            m_subscribers.erase(it);
+            continue;
+        }
+
+        if (!isSubscriberActive(it->widget)) {
+            // 隐藏或未暴露的订阅者暂停，保留订阅，重新显示或暴露时恢复
+            if (!it->paused) {
+                it->paused = true;
+                watchForResume(it->widget);
+            }
+            continue;
+        }
+        it->paused = false;
+        anyActive = true;
+
+        // 拷贝回调，防止回调内部重新订阅时替换正在执行的函数对象
+        const FrameCallback callback = it->callback;
+        callback(delta);
+    }
+
+    // 全部暂停时同样停止，不在最小化或被遮挡的窗口上空转
+    if (m_subscribers.isEmpty() || !anyActive) {
+        stop();
+    }
+}
+
+QT_END_NAMESPACE
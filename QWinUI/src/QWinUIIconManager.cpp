@@ -1,50 +1,277 @@
 #include "QWinUI/QWinUIIconManager.h"
 #include <QApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDirIterator>
 #include <QFileInfo>
+#include <QSaveFile>
 #include <QPainter>
-#include <QDateTime>
+#include <QPaintEngine>
+#include <QPainterPath>
+#include <QRawFont>
+#include <QThread>
 #include <QDebug>
 #include <QStandardPaths>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define QWINUI_ICON_TINT_SSE2
+#endif
 
 QT_BEGIN_NAMESPACE
 
-QWinUIIconManager* QWinUIIconManager::s_instance = nullptr;
+namespace {
+
+// 预乘颜色的四个通道同时乘以 alpha / 255（四舍五入）
+inline quint32 byteMul(quint32 color, quint32 alpha)
+{
+    quint32 t = (color & 0xff00ff) * alpha;
+    t = ((t + ((t >> 8) & 0xff00ff) + 0x800080) >> 8) & 0xff00ff;
+
+    quint32 x = ((color >> 8) & 0xff00ff) * alpha;
+    x = (x + ((x >> 8) & 0xff00ff) + 0x800080) & 0xff00ff00;
+
+    return x | t;
+}
+
+// 按一行alpha遮罩填充预乘颜色，所有通道等比缩放，与字节序无关
+void tintAlphaRow(const uchar* alpha, quint32* dst, int count, quint32 premulColor)
+{
+    int x = 0;
+
+#ifdef QWINUI_ICON_TINT_SSE2
+    // 每次处理4个像素：alpha扩展为16位并复制到4个通道，乘法后除以255再打包
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i color16 = _mm_unpacklo_epi8(_mm_set1_epi32(int(premulColor)), zero);
+    const __m128i half = _mm_set1_epi16(0x80);
+
+    for (; x + 4 <= count; x += 4) {
+        quint32 packed;
+        std::memcpy(&packed, alpha + x, sizeof(packed));
+
+        __m128i a = _mm_cvtsi32_si128(int(packed));
+        a = _mm_unpacklo_epi8(a, a);  // a0 a0 a1 a1 a2 a2 a3 a3
+        a = _mm_unpacklo_epi16(a, a); // 每个像素的alpha重复4次
+
+        __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), color16);
+        __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), color16);
+
+        // v / 255 ≈ (t + (t >> 8)) >> 8，其中 t = v + 128
+        lo = _mm_add_epi16(lo, half);
+        hi = _mm_add_epi16(hi, half);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(lo, hi));
+    }
+#endif
+
+    for (; x < count; ++x) {
+        const quint32 a = alpha[x];
+        if (a == 0) {
+            dst[x] = 0;
+        } else if (a == 255) {
+            dst[x] = premulColor;
+        } else {
+            dst[x] = byteMul(premulColor, a);
+        }
+    }
+}
+
+// 图标包文件格式，与 scripts/generate_icons_qrc.py 保持一致（小端序，各区段4字节对齐）
+constexpr quint32 ICON_PACK_MAGIC = 0x50495751; // 'QWIP'
+constexpr quint16 ICON_PACK_VERSION = 1;
+constexpr int ICON_PACK_MAX_RASTER_SIZES = 8;
+
+enum IconPackCommand : uchar {
+    PackMoveTo = 0,  // x y
+    PackLineTo = 1,  // x y
+    PackCubicTo = 2, // c1x c1y c2x c2y x y
+    PackClose = 3
+};
+
+struct IconPackHeader {
+    quint32_le magic;
+    quint16_le version;
+    quint16_le rasterSizeCount;
+    quint32_le iconCount;
+    quint32_le bucketCount;    // 2的幂，值为 条目索引 + 1，0 表示空桶
+    quint32_le bucketsOffset;
+    quint32_le entriesOffset;
+    quint32_le stringsOffset;
+    quint32_le commandsOffset;
+    quint32_le coordsOffset;
+    quint32_le rastersOffset;
+    quint32_le fileSize;
+    quint16_le rasterSizes[ICON_PACK_MAX_RASTER_SIZES];
+};
+static_assert(sizeof(IconPackHeader) == 60, "Icon pack header layout mismatch");
+
+struct IconPackEntry {
+    quint32_le nameOffset;     // 相对字符串区
+    quint16_le nameLength;
+    quint16_le categoryLength;
+    quint32_le categoryOffset; // 相对字符串区
+    quint32_le viewBox[4];     // float32: x y width height
+    quint32_le commandOffset;  // 相对指令区
+    quint32_le commandCount;
+    quint32_le coordOffset;    // 相对坐标区，以float为单位
+    quint32_le coordCount;
+    quint32_le rasterOffset;   // 文件内绝对偏移，0 表示没有预光栅化遮罩
+    quint32_le reserved;
+};
+static_assert(sizeof(IconPackEntry) == 52, "Icon pack entry layout mismatch");
+
+// FNV-1a 32位哈希
+quint32 iconPackHash(QByteArrayView key)
+{
+    quint32 hash = 0x811C9DC5u;
+    for (char ch : key) {
+        hash ^= uchar(ch);
+        hash *= 0x01000193u;
+    }
+    return hash;
+}
+
+inline const IconPackHeader* packHeader(const uchar* data)
+{
+    return reinterpret_cast<const IconPackHeader*>(data);
+}
+
+inline const IconPackEntry& packEntry(const uchar* data, int index)
+{
+    return reinterpret_cast<const IconPackEntry*>(data + packHeader(data)->entriesOffset)[index];
+}
+
+// 每行按4字节对齐
+inline int packRasterStride(int size)
+{
+    return (size + 3) & ~3;
+}
+
+QByteArrayView packString(const uchar* data, quint32 offset, quint32 length)
+{
+    const IconPackHeader* header = packHeader(data);
+    const quint64 sectionSize = header->commandsOffset - header->stringsOffset;
+    if (quint64(offset) + length > sectionSize) {
+        return QByteArrayView();
+    }
+    return QByteArrayView(reinterpret_cast<const char*>(data + header->stringsOffset + offset), length);
+}
+
+// 名称中以 '-' 分隔的单词作为隐式标签，如 "solid/arrows-rotate" → arrows、rotate
+QStringList iconNameTags(const QString& name)
+{
+    return name.mid(name.lastIndexOf('/') + 1).toLower().split('-', Qt::SkipEmptyParts);
+}
+
+// 只校验头部和区段边界，条目内的偏移在访问时检查
+bool validateIconPack(const uchar* data, qint64 size)
+{
+    if (size < qint64(sizeof(IconPackHeader))) {
+        return false;
+    }
+
+    const IconPackHeader* header = packHeader(data);
+    const quint32 bucketCount = header->bucketCount;
+    if (header->magic != ICON_PACK_MAGIC || header->version != ICON_PACK_VERSION
+        || header->fileSize != size || header->rasterSizeCount > ICON_PACK_MAX_RASTER_SIZES
+        || bucketCount == 0 || (bucketCount & (bucketCount - 1)) != 0) {
+        return false;
+    }
+
+    const quint64 bucketsEnd = quint64(header->bucketsOffset) + quint64(bucketCount) * sizeof(quint32);
+    const quint64 entriesEnd = quint64(header->entriesOffset) + quint64(header->iconCount) * sizeof(IconPackEntry);
+    return header->bucketsOffset >= sizeof(IconPackHeader) && header->bucketsOffset % 4 == 0
+        && bucketsEnd <= header->entriesOffset && header->entriesOffset % 4 == 0
+        && entriesEnd <= header->stringsOffset
+        && header->stringsOffset <= header->commandsOffset
+        && header->commandsOffset <= header->coordsOffset && header->coordsOffset % 4 == 0
+        && header->coordsOffset <= header->rastersOffset
+        && quint64(header->rastersOffset) <= quint64(size);
+}
+
+} // namespace
+
+QAtomicPointer<QWinUIIconManager> QWinUIIconManager::s_instance;
 QMutex QWinUIIconManager::s_mutex;
 const QString QWinUIIconManager::DEFAULT_ICON_DIRECTORY = "Icon";
+const QString QWinUIIconManager::DEFAULT_ICON_PACK = "qwinui_icons.qwip";
 const QString QWinUIIconManager::RESOURCE_ICON_PREFIX = ":/icons";
 
 QWinUIIconManager* QWinUIIconManager::getInstance()
 {
+    // 创建完成后无锁返回，工作线程与GUI线程不在此处竞争
+    if (QWinUIIconManager* instance = s_instance.loadAcquire()) {
+        return instance;
+    }
+
     QMutexLocker locker(&s_mutex);
-    if (!s_instance) {
-        s_instance = new QWinUIIconManager();
+    if (QWinUIIconManager* instance = s_instance.loadRelaxed()) {
+        return instance;
+    }
 
-        // 自动加载资源图标（只加载一次）
-        static bool resourcesLoaded = false;
-        if (!resourcesLoaded) {
-            s_instance->loadIconsFromResources();
-            resourcesLoaded = true;
-        }
+    QWinUIIconManager* instance = new QWinUIIconManager();
+    // 后台光栅化的结果通过排队调用回到管理器所在线程，首次调用可能来自工作线程
+    if (QCoreApplication* app = QCoreApplication::instance()) {
+        instance->moveToThread(app->thread());
+    }
 
-        // 自动加载默认图标目录（如果存在）
-        QString defaultPath = QApplication::applicationDirPath() + "/" + DEFAULT_ICON_DIRECTORY;
-        if (QDir(defaultPath).exists()) {
-            s_instance->loadIconsFromDirectory(defaultPath);
-        }
+    // 自动加载构建时生成的图标包（内存映射，不逐个解析图标）
+    const QString packPath = defaultIconPackPath();
+    if (QFile::exists(packPath)) {
+        instance->loadIconPack(packPath);
+    } else {
+        qWarning() << "Built-in icon pack not found, set QWINUI_ICON_PACK to its location:" << packPath;
+    }
+
+    // 自动加载默认图标目录（如果存在）
+    QString defaultPath = QApplication::applicationDirPath() + "/" + DEFAULT_ICON_DIRECTORY;
+    if (QDir(defaultPath).exists()) {
+        instance->loadIconsFromDirectory(defaultPath);
     }
-    return s_instance;
+
+    // 初始化完成后再发布，其他线程不会看到加载到一半的实例
+    s_instance.storeRelease(instance);
+    return instance;
 }
 
 QWinUIIconManager::QWinUIIconManager(QObject* parent)
     : QObject(parent)
-    , m_cacheLimit(100)
+    , m_documents(64)
+    , m_vectors(64)
+    , m_documentHits(0)
+    , m_documentMisses(0)
+    , m_glyphPaths(512)
+    , m_cacheLimit(1024)
+    , m_cacheByteLimit(DEFAULT_CACHE_BYTE_LIMIT)
+    , m_rasterCount(0)
+    , m_rasterBytes(0)
+    , m_rasterClock(0)
+    , m_asyncRunning(0)
+    , m_maxAsyncJobs(qMax(1, QThread::idealThreadCount() / 2))
+    , m_indexValid(false)
+    , m_packData(nullptr)
+    , m_packSize(0)
 {
+    m_asyncPool.setMaxThreadCount(m_maxAsyncJobs);
 }
 
 QWinUIIconManager::~QWinUIIconManager()
 {
+    // 丢弃排队的任务并等待正在运行的任务结束，它们的结果回调随管理器一起失效
+    {
+        QMutexLocker locker(&m_asyncMutex);
+        m_asyncQueue.clear();
+    }
+    m_asyncPool.waitForDone();
+
     clearCache();
+    unloadIconPack();
 }
 
 bool QWinUIIconManager::loadIconsFromDirectory(const QString& directory)
@@ -54,47 +281,57 @@ bool QWinUIIconManager::loadIconsFromDirectory(const QString& directory)
         qWarning() << "Icon directory does not exist:" << directory;
         return false;
     }
+    const QString absolutePath = iconDir.absolutePath();
     
-    QDirIterator iterator(directory, QStringList() << "*.svg", QDir::Files, QDirIterator::Subdirectories);
-    int loadedCount = 0;
-    
-    while (iterator.hasNext()) {
-        QString filePath = iterator.next();
-        QFileInfo fileInfo(filePath);
-        QString iconName = getIconNameFromPath(filePath);
-        
-        // 从目录结构推断分类
-        QString relativePath = iconDir.relativeFilePath(filePath);
-        QString category = QFileInfo(relativePath).dir().dirName();
-        if (category == ".") {
-            category = "General";
+    // 有清单时直接按清单注册，启动阶段不读取任何图标文件
+    IconManifest manifest;
+    if (readManifest(absolutePath, &manifest)) {
+        for (const ManifestEntry& entry : std::as_const(manifest.entries)) {
+            registerManifestEntry(absolutePath, entry);
         }
+        invalidateIconIndex();
         
-        if (registerIcon(iconName, filePath, category)) {
-            loadedCount++;
+        if (!isManifestCurrent(manifest)) {
+            rescanIconDirectory(manifest);
         }
+        
+        qDebug() << "Loaded" << manifest.entries.size() << "icons from manifest of" << directory;
+        return !manifest.entries.isEmpty();
     }
     
-    qDebug() << "Loaded" << loadedCount << "icons from" << directory;
-    return loadedCount > 0;
+    // 首次加载：同步扫描并写入清单
+    manifest = scanIconDirectory(absolutePath, IconManifest());
+    for (const ManifestEntry& entry : std::as_const(manifest.entries)) {
+        registerManifestEntry(absolutePath, entry);
+    }
+    invalidateIconIndex();
+    writeManifest(manifest);
+    
+    qDebug() << "Loaded" << manifest.entries.size() << "icons from" << directory;
+    return !manifest.entries.isEmpty();
 }
 
 bool QWinUIIconManager::loadIconsFromResources(const QString& resourcePrefix)
 {
-    // 只加载测试需要的几个基础图标，避免启动卡顿
-    QStringList basicIcons = {
-        "solid/house",
-        "solid/heart",
-        "solid/arrows-rotate"
-    };
+    // 注册应用自带QRC中的图标（每个图标都会解析一次，大量图标请使用图标包）
+    QDir resourceDir(resourcePrefix);
+    if (!resourceDir.exists()) {
+        qWarning() << "Resource icon prefix does not exist:" << resourcePrefix;
+        return false;
+    }
 
+    QDirIterator iterator(resourcePrefix, QDir::Files, QDirIterator::Subdirectories);
     int loadedCount = 0;
-    for (const QString& iconPath : basicIcons) {
-        QString resourcePath = resourcePrefix + "/" + iconPath;
-        QString iconName = iconPath;
+
+    while (iterator.hasNext()) {
+        QString resourcePath = iterator.next();
+        QString iconName = resourceDir.relativeFilePath(resourcePath);
+        if (iconName.endsWith(".svg", Qt::CaseInsensitive)) {
+            iconName.chop(4);
+        }
 
         // 从路径推断分类
-        QStringList parts = iconPath.split('/');
+        QStringList parts = iconName.split('/');
         QString category = parts.size() > 1 ? parts[0] : "general";
 
         if (registerResourceIcon(iconName, resourcePath, category)) {
@@ -102,7 +339,7 @@ bool QWinUIIconManager::loadIconsFromResources(const QString& resourcePrefix)
         }
     }
 
-    qDebug() << "Loaded" << loadedCount << "basic icons from resources";
+    qDebug() << "Loaded" << loadedCount << "icons from resources";
     return loadedCount > 0;
 }
 
@@ -129,12 +366,218 @@ bool QWinUIIconManager::registerIcon(const QString& name, const QString& filePat
         return false;
     }
     
-    m_icons[name] = iconInfo;
+    {
+        QWriteLocker locker(&m_registryLock);
+        m_icons[name] = iconInfo;
+    }
+    invalidateIconIndex();
     emit iconRegistered(name);
     
     return true;
 }
 
+QString QWinUIIconManager::manifestPath(const QString& directory)
+{
+    // 按目录绝对路径区分清单，哈希需在多次运行之间保持稳定
+    const QByteArray digest = QCryptographicHash::hash(directory.toUtf8(), QCryptographicHash::Md5).toHex();
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+        + "/qwinui_icons_" + QString::fromLatin1(digest) + ".manifest";
+}
+
+bool QWinUIIconManager::readManifest(const QString& directory, IconManifest* manifest)
+{
+    QFile file(manifestPath(directory));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != MANIFEST_MAGIC || version != MANIFEST_VERSION) {
+        return false;
+    }
+
+    IconManifest result;
+    quint32 count = 0;
+    stream >> result.directory >> result.directories >> count;
+    if (stream.status() != QDataStream::Ok || result.directory != directory) {
+        return false;
+    }
+
+    result.entries.reserve(count);
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        ManifestEntry entry;
+        stream >> entry.relativePath >> entry.size >> entry.modified
+               >> entry.name >> entry.category >> entry.originalSize;
+        result.entries.append(entry);
+    }
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "Corrupted icon manifest:" << file.fileName();
+        return false;
+    }
+
+    *manifest = std::move(result);
+    return true;
+}
+
+bool QWinUIIconManager::writeManifest(const IconManifest& manifest)
+{
+    const QString path = manifestPath(manifest.directory);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    // 先写临时文件再替换，其他进程不会读到写了一半的清单
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write icon manifest:" << path;
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << MANIFEST_MAGIC << MANIFEST_VERSION
+           << manifest.directory << manifest.directories << quint32(manifest.entries.size());
+    for (const ManifestEntry& entry : manifest.entries) {
+        stream << entry.relativePath << entry.size << entry.modified
+               << entry.name << entry.category << entry.originalSize;
+    }
+
+    return file.commit();
+}
+
+bool QWinUIIconManager::isManifestCurrent(const IconManifest& manifest)
+{
+    // 增删文件会更新所在目录的修改时间，每个目录只需一次 stat
+    const QDir root(manifest.directory);
+    for (auto it = manifest.directories.cbegin(); it != manifest.directories.cend(); ++it) {
+        const QFileInfo info(root.filePath(it.key()));
+        if (!info.isDir() || info.lastModified().toMSecsSinceEpoch() != it.value()) {
+            return false;
+        }
+    }
+    return !manifest.directories.isEmpty();
+}
+
+QWinUIIconManager::IconManifest QWinUIIconManager::scanIconDirectory(const QString& directory, const IconManifest& previous)
+{
+    IconManifest manifest;
+    manifest.directory = directory;
+
+    const QDir iconDir(directory);
+    manifest.directories.insert(".", QFileInfo(directory).lastModified().toMSecsSinceEpoch());
+    QDirIterator dirIterator(directory, QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (dirIterator.hasNext()) {
+        dirIterator.next();
+        const QFileInfo info = dirIterator.fileInfo();
+        manifest.directories.insert(iconDir.relativeFilePath(info.filePath()), info.lastModified().toMSecsSinceEpoch());
+    }
+
+    QHash<QString, const ManifestEntry*> known;
+    known.reserve(previous.entries.size());
+    for (const ManifestEntry& entry : previous.entries) {
+        known.insert(entry.relativePath, &entry);
+    }
+
+    QDirIterator iterator(directory, QStringList() << "*.svg", QDir::Files, QDirIterator::Subdirectories);
+    while (iterator.hasNext()) {
+        const QString filePath = iterator.next();
+        const QFileInfo fileInfo = iterator.fileInfo();
+
+        ManifestEntry entry;
+        entry.relativePath = iconDir.relativeFilePath(filePath);
+        entry.size = fileInfo.size();
+        entry.modified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+        // 大小和修改时间都未变，沿用旧清单的解析结果
+        const ManifestEntry* old = known.value(entry.relativePath, nullptr);
+        if (old && old->size == entry.size && old->modified == entry.modified) {
+            manifest.entries.append(*old);
+            continue;
+        }
+
+        // 从目录结构推断分类
+        entry.name = getIconNameFromPath(filePath);
+        entry.category = QFileInfo(entry.relativePath).dir().dirName();
+        if (entry.category == ".") {
+            entry.category = "General";
+        }
+
+        // 加载SVG以获取原始尺寸
+        QSvgRenderer renderer(filePath);
+        if (!renderer.isValid()) {
+            qWarning() << "Invalid SVG file:" << filePath;
+            continue;
+        }
+        entry.originalSize = renderer.defaultSize();
+        manifest.entries.append(entry);
+    }
+
+    return manifest;
+}
+
+void QWinUIIconManager::registerManifestEntry(const QString& directory, const ManifestEntry& entry)
+{
+    QWinUIIconInfo iconInfo(entry.name, directory + "/" + entry.relativePath, entry.category);
+    iconInfo.originalSize = entry.originalSize;
+    {
+        QWriteLocker locker(&m_registryLock);
+        m_icons[entry.name] = iconInfo;
+    }
+    emit iconRegistered(entry.name);
+}
+
+void QWinUIIconManager::rescanIconDirectory(const IconManifest& previous)
+{
+    // 扫描和SVG解析在线程池中进行，注册表只在管理器所在线程修改
+    QWinUIIconManager* self = this;
+    m_asyncPool.start([self, previous]() {
+        const IconManifest current = scanIconDirectory(previous.directory, previous);
+        QMetaObject::invokeMethod(self, [self, previous, current]() {
+            self->applyManifestDelta(previous, current);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void QWinUIIconManager::applyManifestDelta(const IconManifest& previous, const IconManifest& current)
+{
+    QHash<QString, const ManifestEntry*> known;
+    known.reserve(previous.entries.size());
+    for (const ManifestEntry& entry : previous.entries) {
+        known.insert(entry.relativePath, &entry);
+    }
+
+    int changed = 0;
+    for (const ManifestEntry& entry : current.entries) {
+        const ManifestEntry* old = known.take(entry.relativePath);
+        if (old && old->size == entry.size && old->modified == entry.modified) {
+            continue;
+        }
+        if (old && hasIcon(old->name)) {
+            // 文件内容已变，丢弃旧的文档和光栅图
+            clearCache(old->name);
+        }
+        registerManifestEntry(current.directory, entry);
+        ++changed;
+    }
+
+    // 剩下的是已删除的文件；同名图标已被其他文件重新注册时保留
+    for (const ManifestEntry* removed : std::as_const(known)) {
+        if (getIconInfo(removed->name).filePath == current.directory + "/" + removed->relativePath) {
+            unregisterIcon(removed->name);
+            ++changed;
+        }
+    }
+
+    invalidateIconIndex();
+    writeManifest(current);
+
+    qDebug() << "Rescanned" << current.directory << ":" << changed << "icons changed";
+    emit iconDirectoryUpdated(current.directory);
+}
+
 bool QWinUIIconManager::registerResourceIcon(const QString& name, const QString& resourcePath, const QString& category)
 {
     if (name.isEmpty() || resourcePath.isEmpty()) {
@@ -165,7 +608,11 @@ bool QWinUIIconManager::registerResourceIcon(const QString& name, const QString&
         iconInfo.originalSize = QSize(24, 24);
     }
 
-    m_icons[name] = iconInfo;
+    {
+        QWriteLocker locker(&m_registryLock);
+        m_icons[name] = iconInfo;
+    }
+    invalidateIconIndex();
     emit iconRegistered(name);
 
     return true;
@@ -173,209 +620,1542 @@ bool QWinUIIconManager::registerResourceIcon(const QString& name, const QString&
 
 void QWinUIIconManager::unregisterIcon(const QString& name)
 {
-    if (m_icons.remove(name)) {
+    if (hasIcon(name)) {
+        // 缓存按文件路径索引，需在移除注册信息之前清理
         clearCache(name);
+        {
+            QWriteLocker locker(&m_registryLock);
+            m_icons.remove(name);
+        }
+        invalidateIconIndex();
         emit iconUnregistered(name);
     }
 }
 
-bool QWinUIIconManager::hasIcon(const QString& name) const
+bool QWinUIIconManager::loadIconPack(const QString& packFile)
 {
-    return m_icons.contains(name);
-}
+    unloadIconPack();
 
-QWinUIIconInfo QWinUIIconManager::getIconInfo(const QString& name) const
-{
-    return m_icons.value(name);
-}
+    QWriteLocker locker(&m_packLock);
+    m_packFile.setFileName(packFile);
+    if (!m_packFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open icon pack:" << packFile;
+        return false;
+    }
 
-QStringList QWinUIIconManager::getIconNames() const
-{
-    return m_icons.keys();
+    const qint64 size = m_packFile.size();
+    const uchar* data = m_packFile.map(0, size);
+    if (!data || !validateIconPack(data, size)) {
+        qWarning() << "Invalid icon pack:" << packFile;
+        m_packFile.close(); // 关闭文件时自动解除映射
+        return false;
+    }
+
+    m_packData = data;
+    m_packSize = size;
+    locker.unlock();
+    invalidateIconIndex();
+
+    qDebug() << "Loaded" << getIconPackSize() << "icons from pack" << packFile;
+    return true;
 }
 
-QStringList QWinUIIconManager::getIconsByCategory(const QString& category) const
+void QWinUIIconManager::unloadIconPack()
 {
-    QStringList result;
-    for (auto it = m_icons.begin(); it != m_icons.end(); ++it) {
-        if (it.value().category == category) {
-            result.append(it.key());
+    {
+        // 写锁等待所有正在使用图标包的绘制完成
+        QWriteLocker locker(&m_packLock);
+        if (!m_packData) {
+            return;
+        }
+
+        // 缓存中的预光栅化遮罩直接引用映射内存，必须先于解除映射清空
+        clearRasterCache();
+        {
+            QMutexLocker documentLocker(&m_documentMutex);
+            m_vectors.clear();
         }
+
+        m_packFile.unmap(const_cast<uchar*>(m_packData));
+        m_packFile.close();
+        m_packData = nullptr;
+        m_packSize = 0;
     }
-    return result;
+    invalidateIconIndex();
+    emit cacheCleared();
 }
 
-QStringList QWinUIIconManager::getIconsByTag(const QString& tag) const
+bool QWinUIIconManager::hasIconPack() const
 {
-    QStringList result;
-    for (auto it = m_icons.begin(); it != m_icons.end(); ++it) {
-        if (it.value().tags.contains(tag)) {
-            result.append(it.key());
-        }
-    }
-    return result;
+    QReadLocker locker(&m_packLock);
+    return m_packData != nullptr;
 }
 
-QStringList QWinUIIconManager::getCategories() const
+int QWinUIIconManager::getIconPackSize() const
 {
-    QStringList categories;
-    for (auto it = m_icons.begin(); it != m_icons.end(); ++it) {
-        const QString& category = it.value().category;
-        if (!category.isEmpty() && !categories.contains(category)) {
-            categories.append(category);
-        }
-    }
-    categories.sort();
-    return categories;
+    QReadLocker locker(&m_packLock);
+    return packIconCount();
 }
 
-QPixmap QWinUIIconManager::getIcon(const QString& name, const QSize& size, const QColor& color) const
+int QWinUIIconManager::packIconCount() const
 {
-    if (!hasIcon(name)) {
-        qWarning() << "Icon not found:" << name;
-        return QPixmap();
+    return m_packData ? int(packHeader(m_packData)->iconCount) : 0;
+}
+
+QString QWinUIIconManager::defaultIconPackPath()
+{
+    // 环境变量指定的路径优先，便于打包后的应用和测试指定图标包
+    const QString overridePath = qEnvironmentVariable("QWINUI_ICON_PACK");
+    if (!overridePath.isEmpty()) {
+        return overridePath;
     }
-    
-    QString cacheKey = getCacheKey(name, size, color);
-    
-    QMutexLocker locker(&m_cacheMutex);
-    
-    // 检查缓存
-    if (m_cache.contains(cacheKey)) {
-        QWinUIIconCacheItem* item = m_cache[cacheKey];
-        item->lastAccessed = QDateTime::currentMSecsSinceEpoch();
-        return item->pixmap;
+
+    // 可执行文件旁边（随应用分发），其次是库的安装目录，最后是库构建时生成的位置：
+    // 构建树中输出目录与库不同的可执行文件（如顶层的 QWinUIDemo）也能找到内置图标
+    const QString localPath = QApplication::applicationDirPath() + "/" + DEFAULT_ICON_PACK;
+    if (QFile::exists(localPath)) {
+        return localPath;
     }
-    
-    // 创建新的缓存项
-    QWinUIIconCacheItem* item = new QWinUIIconCacheItem();
-    const QWinUIIconInfo& iconInfo = m_icons[name];
-    
-    item->renderer = new QSvgRenderer(iconInfo.filePath);
-    if (!item->renderer->isValid()) {
-        delete item;
-        return QPixmap();
+#ifdef QWINUI_ICON_PACK_INSTALL_DIR
+    const QString installedPath = QStringLiteral(QWINUI_ICON_PACK_INSTALL_DIR) + "/" + DEFAULT_ICON_PACK;
+    if (QFile::exists(installedPath)) {
+        return installedPath;
     }
-    
-    // 渲染图标
-    QSize renderSize = size.isValid() ? size : QSize(16, 16);
-    item->pixmap = QPixmap(renderSize);
-    item->pixmap.fill(Qt::transparent);
-    
-    QPainter painter(&item->pixmap);
-    painter.setRenderHint(QPainter::Antialiasing);
-    item->renderer->render(&painter);
-    
-    // 应用颜色
-    if (color.isValid()) {
-        item->pixmap = colorizePixmap(item->pixmap, color);
+#endif
+#ifdef QWINUI_ICON_PACK_BUILD_PATH
+    const QString buildPath = QStringLiteral(QWINUI_ICON_PACK_BUILD_PATH);
+    if (QFile::exists(buildPath)) {
+        return buildPath;
     }
-    
-    item->lastColor = color;
-    item->lastSize = renderSize;
-    item->lastAccessed = QDateTime::currentMSecsSinceEpoch();
-    
-    // 添加到缓存
-    m_cache[cacheKey] = item;
-    
-    // 清理缓存
-    if (m_cache.size() > m_cacheLimit) {
-        cleanupCache();
+#endif
+    return localPath;
+}
+
+bool QWinUIIconManager::hasIcon(const QString& name) const
+{
+    {
+        QReadLocker locker(&m_registryLock);
+        if (m_icons.contains(name)) {
+            return true;
+        }
     }
-    
-    return item->pixmap;
+    QReadLocker packLocker(&m_packLock);
+    return findPackIcon(name) >= 0;
 }
 
-QSvgRenderer* QWinUIIconManager::getRenderer(const QString& name) const
+QWinUIIconInfo QWinUIIconManager::getIconInfo(const QString& name) const
 {
-    if (!hasIcon(name)) {
-        return nullptr;
+    {
+        QReadLocker locker(&m_registryLock);
+        auto it = m_icons.constFind(name);
+        if (it != m_icons.constEnd()) {
+            return it.value();
+        }
     }
-    
-    const QWinUIIconInfo& iconInfo = m_icons[name];
-    return new QSvgRenderer(iconInfo.filePath);
+
+    QReadLocker packLocker(&m_packLock);
+    const int index = findPackIcon(name);
+    if (index < 0) {
+        return QWinUIIconInfo();
+    }
+
+    QWinUIIconInfo info(name, RESOURCE_ICON_PREFIX + "/" + name, packIconCategory(index));
+    info.originalSize = packIconViewBox(index).size().toSize();
+    info.tags = iconNameTags(name);
+    return info;
 }
 
-void QWinUIIconManager::clearCache()
+QStringList QWinUIIconManager::getIconNames() const
 {
-    QMutexLocker locker(&m_cacheMutex);
-    qDeleteAll(m_cache);
-    m_cache.clear();
-    emit cacheCleared();
+    QMutexLocker locker(&m_indexMutex);
+    return iconIndex().names;
 }
 
-void QWinUIIconManager::clearCache(const QString& name)
+QStringList QWinUIIconManager::getIconsByCategory(const QString& category) const
 {
-    QMutexLocker locker(&m_cacheMutex);
-    auto it = m_cache.begin();
-    while (it != m_cache.end()) {
-        if (it.key().startsWith(name + "|")) {
-            delete it.value();
-            it = m_cache.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    QMutexLocker locker(&m_indexMutex);
+    return iconNamesForIds(iconIndex().categories.value(category));
 }
 
-void QWinUIIconManager::setCacheLimit(int maxItems)
+QStringList QWinUIIconManager::getIconsByTag(const QString& tag) const
 {
-    m_cacheLimit = qMax(10, maxItems);
-    if (m_cache.size() > m_cacheLimit) {
-        cleanupCache();
-    }
+    QMutexLocker locker(&m_indexMutex);
+    return iconNamesForIds(iconIndex().tags.value(tag.toLower()));
 }
 
-int QWinUIIconManager::getCacheSize() const
+QStringList QWinUIIconManager::getCategories() const
 {
-    QMutexLocker locker(&m_cacheMutex);
-    return m_cache.size();
+    QMutexLocker locker(&m_indexMutex);
+    return iconIndex().categoryNames;
 }
 
-QPixmap QWinUIIconManager::colorizePixmap(const QPixmap& pixmap, const QColor& color)
+QStringList QWinUIIconManager::findIconsByPrefix(const QString& prefix, int limit) const
 {
-    if (pixmap.isNull() || !color.isValid()) {
-        return pixmap;
+    QMutexLocker locker(&m_indexMutex);
+    const IconIndex& index = iconIndex();
+    const QString key = prefix.toLower();
+    if (key.isEmpty()) {
+        return limit < 0 ? index.names : index.names.mid(0, limit);
     }
-    
-    QPixmap colorized = pixmap;
-    QPainter painter(&colorized);
-    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
-    painter.fillRect(colorized.rect(), color);
-    return colorized;
+
+    // 有序键上二分查找前缀区间
+    auto it = std::lower_bound(index.prefixKeys.cbegin(), index.prefixKeys.cend(), key,
+                               [](const QPair<QString, int>& entry, const QString& value) {
+                                   return entry.first < value;
+                               });
+
+    QList<int> ids;
+    for (; it != index.prefixKeys.cend() && it->first.startsWith(key); ++it) {
+        ids.append(it->second);
+    }
+
+    // 完整名称和基础名称可能同时命中
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return iconNamesForIds(ids, limit);
 }
 
-QString QWinUIIconManager::getIconNameFromPath(const QString& filePath)
+QStringList QWinUIIconManager::findIconsContaining(const QString& text, int limit) const
 {
-    QFileInfo fileInfo(filePath);
-    return fileInfo.baseName();
+    QMutexLocker locker(&m_indexMutex);
+    const IconIndex& index = iconIndex();
+    const QString key = text.toLower();
+
+    QStringList result;
+    for (int id = 0; id < index.lowerNames.size(); ++id) {
+        if (limit >= 0 && result.size() >= limit) {
+            break;
+        }
+        if (index.lowerNames.at(id).contains(key)) {
+            result.append(index.names.at(id));
+        }
+    }
+    return result;
 }
 
-void QWinUIIconManager::cleanupCache() const
+const QWinUIIconManager::IconIndex& QWinUIIconManager::iconIndex() const
 {
-    if (m_cache.size() <= m_cacheLimit) {
-        return;
+    if (m_indexValid) {
+        return m_index;
+    }
+
+    // 构建期间注册表和图标包都不能变化（加锁顺序：m_indexMutex → m_registryLock → m_packLock）
+    QReadLocker registryLocker(&m_registryLock);
+    QReadLocker packLocker(&m_packLock);
+
+    // 已注册的图标优先于图标包中的同名图标（packIndex 为 -1 表示已注册的图标）
+    const int packSize = packIconCount();
+    QList<QPair<QString, int>> sources;
+    sources.reserve(m_icons.size() + packSize);
+    for (auto it = m_icons.cbegin(); it != m_icons.cend(); ++it) {
+        sources.append(qMakePair(it.key(), -1));
+    }
+    for (int i = 0; i < packSize; ++i) {
+        const QString name = packIconName(i);
+        if (!m_icons.contains(name)) {
+            sources.append(qMakePair(name, i));
+        }
+    }
+    std::sort(sources.begin(), sources.end());
+
+    IconIndex index;
+    index.names.reserve(sources.size());
+    index.lowerNames.reserve(sources.size());
+    index.prefixKeys.reserve(sources.size() * 2);
+
+    for (int id = 0; id < sources.size(); ++id) {
+        const QString& name = sources.at(id).first;
+        const int packIndex = sources.at(id).second;
+
+        QString category;
+        QStringList tags = iconNameTags(name);
+        if (packIndex >= 0) {
+            category = packIconCategory(packIndex);
+        } else {
+            const QWinUIIconInfo& info = *m_icons.constFind(name);
+            category = info.category;
+            for (const QString& tag : info.tags) {
+                tags.append(tag.toLower());
+            }
+        }
+
+        const QString lowerName = name.toLower();
+        index.names.append(name);
+        index.lowerNames.append(lowerName);
+        index.prefixKeys.append(qMakePair(lowerName, id));
+        const int slash = lowerName.lastIndexOf('/');
+        if (slash >= 0) {
+            index.prefixKeys.append(qMakePair(lowerName.mid(slash + 1), id));
+        }
+
+        if (!category.isEmpty()) {
+            index.categories[category].append(id);
+        }
+        tags.removeDuplicates();
+        for (const QString& tag : tags) {
+            index.tags[tag].append(id);
+        }
+    }
+
+    std::sort(index.prefixKeys.begin(), index.prefixKeys.end());
+    index.categoryNames = index.categories.keys();
+    index.categoryNames.sort();
+
+    m_index = std::move(index);
+    m_indexValid = true;
+    return m_index;
+}
+
+void QWinUIIconManager::invalidateIconIndex()
+{
+    QMutexLocker locker(&m_indexMutex);
+    m_indexValid = false;
+    m_index = IconIndex();
+}
+
+QStringList QWinUIIconManager::iconNamesForIds(const QList<int>& ids, int limit) const
+{
+    // 调用方需持有 m_indexMutex，ID 已按名称排序
+    const int count = limit < 0 ? int(ids.size()) : qMin(limit, int(ids.size()));
+    QStringList result;
+    result.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        result.append(m_index.names.at(ids.at(i)));
+    }
+    return result;
+}
+
+QPixmap QWinUIIconManager::getIcon(const QString& name, const QSize& size, const QColor& color, qreal devicePixelRatio) const
+{
+    const QImage image = getIconImage(name, size, color, devicePixelRatio);
+    return image.isNull() ? QPixmap() : QPixmap::fromImage(image);
+}
+
+QPixmap QWinUIIconManager::getIconFromFile(const QString& filePath, const QSize& size, const QColor& color, qreal devicePixelRatio) const
+{
+    const QImage image = getIconImageFromFile(filePath, size, color, devicePixelRatio);
+    return image.isNull() ? QPixmap() : QPixmap::fromImage(image);
+}
+
+QImage QWinUIIconManager::getIconImage(const QString& name, const QSize& size, const QColor& color, qreal devicePixelRatio) const
+{
+    const QString filePath = iconFilePath(name);
+    if (filePath.isEmpty()) {
+        qWarning() << "Icon not found:" << name;
+        return QImage();
     }
     
-    // 按最后访问时间排序，删除最旧的项
-    QList<QPair<qint64, QString>> accessTimes;
-    for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
-        accessTimes.append(qMakePair(it.value()->lastAccessed, it.key()));
+    return getIconImageFromFile(filePath, size, color, devicePixelRatio);
+}
+
+QImage QWinUIIconManager::getIconImageFromFile(const QString& filePath, const QSize& size, const QColor& color, qreal devicePixelRatio) const
+{
+    if (filePath.isEmpty()) {
+        return QImage();
     }
+
+    QSize renderSize = size.isValid() ? size : QSize(16, 16);
+    const qreal dpr = devicePixelRatio > 0.0 ? devicePixelRatio : 1.0;
+    const bool colorize = color.isValid();
+    const RasterKey cacheKey = getCacheKey(filePath, renderSize, colorize, dpr);
     
-    std::sort(accessTimes.begin(), accessTimes.end());
+    // 缓存中的遮罩可能引用图标包的映射内存，使用期间持有读锁
+    QReadLocker packLocker(&m_packLock);
     
-    int itemsToRemove = m_cache.size() - m_cacheLimit + 10; // 多删除一些以避免频繁清理
-    for (int i = 0; i < itemsToRemove && i < accessTimes.size(); ++i) {
-        const QString& key = accessTimes[i].second;
-        delete m_cache[key];
-        m_cache.remove(key);
+    RasterShard& shard = shardFor(cacheKey);
+    QMutexLocker locker(&shard.mutex);
+    
+    for (;;) {
+        // 检查光栅缓存
+        if (RasterNode* node = touchRasterNode(shard, cacheKey)) {
+            if (!colorize) {
+                return node->item.image;
+            }
+
+            // 遮罩是隐式共享的，着色不需要持有缓存锁
+            const QImage mask = node->item.mask;
+            locker.unlock();
+            return tintAlphaMask(mask, color);
+        }
+
+        // 其他线程正在光栅化同一个键，等待完成后重新查找
+        if (!shard.pending.contains(cacheKey)) {
+            break;
+        }
+        ++shard.waits;
+        shard.rasterized.wait(&shard.mutex);
+    }
+    ++shard.misses;
+    shard.pending.insert(cacheKey);
+    
+    // 光栅化期间不持有分片锁，同一分片中的其他键仍可命中
+    locker.unlock();
+    QImage image = rasterize(filePath, renderSize, dpr, colorize);
+    locker.relock();
+    
+    shard.pending.remove(cacheKey);
+    shard.rasterized.wakeAll();
+    if (image.isNull()) {
+        return QImage();
+    }
+    
+    // 添加到缓存（后台任务可能已先写入同一个键）
+    const RasterNode* node = shard.cache.value(cacheKey, nullptr);
+    if (!node) {
+        node = insertRasterNode(shard, cacheKey, image, renderSize);
+    }
+    const QImage cached = colorize ? node->item.mask : node->item.image;
+    locker.unlock();
+    
+    // 清理缓存（跨分片淘汰，不能持有分片锁）
+    cleanupCache(&cacheKey);
+    
+    return colorize ? tintAlphaMask(cached, color) : cached;
+}
+
+QPainterPath QWinUIIconManager::getGlyphPath(const QString& fontFamily, QChar glyph, int pixelSize) const
+{
+    if (fontFamily.isEmpty() || glyph.isNull() || pixelSize <= 0) {
+        return QPainterPath();
+    }
+
+    const GlyphKey key{fontFamily, glyph.unicode(), pixelSize};
+    QMutexLocker locker(&m_glyphMutex);
+    if (const QPainterPath* cached = m_glyphPaths.object(key)) {
+        return *cached;
+    }
+
+    QFont font(fontFamily);
+    font.setPixelSize(pixelSize);
+    const QRawFont rawFont = QRawFont::fromFont(font);
+
+    QPainterPath* path = new QPainterPath();
+    if (rawFont.isValid()) {
+        const QList<quint32> glyphIndexes = rawFont.glyphIndexesForString(QString(glyph));
+        // 索引 0 为 .notdef，说明解析到的字体不含该字符
+        if (glyphIndexes.size() == 1 && glyphIndexes.first() != 0) {
+            const QList<QPointF> advances = rawFont.advancesForGlyphIndexes(glyphIndexes);
+            const qreal advance = advances.isEmpty() ? 0.0 : advances.first().x();
+            *path = rawFont.pathForGlyph(glyphIndexes.first());
+            // 轮廓原点在基线上，平移到前进宽度 × 行高的中心
+            path->translate(-advance / 2.0, (rawFont.ascent() - rawFont.descent()) / 2.0);
+        }
+    }
+
+    const QPainterPath result = *path;
+    m_glyphPaths.insert(key, path);
+    return result;
+}
+
+QPixmap QWinUIIconManager::requestIcon(const QString& name, const QSize& size, const QColor& color, qreal devicePixelRatio, bool* ready) const
+{
+    const QString filePath = iconFilePath(name);
+    if (filePath.isEmpty()) {
+        qWarning() << "Icon not found:" << name;
+        if (ready) {
+            *ready = true;
+        }
+        return QPixmap();
+    }
+    
+    return requestIconFromFile(filePath, size, color, devicePixelRatio, ready);
+}
+
+QPixmap QWinUIIconManager::requestIconFromFile(const QString& filePath, const QSize& size, const QColor& color, qreal devicePixelRatio, bool* ready) const
+{
+    if (ready) {
+        *ready = true;
+    }
+    if (filePath.isEmpty()) {
+        return QPixmap();
+    }
+
+    QSize renderSize = size.isValid() ? size : QSize(16, 16);
+    const qreal dpr = devicePixelRatio > 0.0 ? devicePixelRatio : 1.0;
+    const bool colorize = color.isValid();
+    const RasterKey cacheKey = getCacheKey(filePath, renderSize, colorize, dpr);
+    
+    // 缓存中的遮罩可能引用图标包的映射内存，使用期间持有读锁
+    QReadLocker packLocker(&m_packLock);
+    
+    {
+        RasterShard& shard = shardFor(cacheKey);
+        QMutexLocker locker(&shard.mutex);
+        if (RasterNode* node = touchRasterNode(shard, cacheKey)) {
+            const QImage cached = colorize ? node->item.mask : node->item.image;
+            locker.unlock();
+            return QPixmap::fromImage(colorize ? tintAlphaMask(cached, color) : cached);
+        }
+        ++shard.misses;
+    }
+    
+    if (ready) {
+        *ready = false;
+    }
+    queueAsyncRaster(filePath, cacheKey, renderSize, dpr);
+    return placeholderIcon(cacheKey, renderSize, color, dpr);
+}
+
+void QWinUIIconManager::prefetchIcons(const QStringList& names, const QSize& size, const QColor& color, qreal devicePixelRatio) const
+{
+    const QSize renderSize = size.isValid() ? size : QSize(16, 16);
+    const qreal dpr = devicePixelRatio > 0.0 ? devicePixelRatio : 1.0;
+
+    for (const QString& name : names) {
+        const QString filePath = iconFilePath(name);
+        if (filePath.isEmpty()) {
+            continue;
+        }
+
+        const RasterKey cacheKey = getCacheKey(filePath, renderSize, color.isValid(), dpr);
+        {
+            RasterShard& shard = shardFor(cacheKey);
+            QMutexLocker locker(&shard.mutex);
+            if (shard.cache.contains(cacheKey)) {
+                continue;
+            }
+        }
+        queueAsyncRaster(filePath, cacheKey, renderSize, dpr);
+    }
+}
+
+void QWinUIIconManager::setMaxAsyncJobs(int maxJobs)
+{
+    {
+        QMutexLocker locker(&m_asyncMutex);
+        m_maxAsyncJobs = qMax(1, maxJobs);
+        m_asyncPool.setMaxThreadCount(m_maxAsyncJobs);
+    }
+    startAsyncJobs();
+}
+
+int QWinUIIconManager::maxAsyncJobs() const
+{
+    QMutexLocker locker(&m_asyncMutex);
+    return m_maxAsyncJobs;
+}
+
+QString QWinUIIconManager::iconFilePath(const QString& name) const
+{
+    {
+        QReadLocker locker(&m_registryLock);
+        auto info = m_icons.constFind(name);
+        if (info != m_icons.constEnd()) {
+            return info->filePath;
+        }
+    }
+    QReadLocker packLocker(&m_packLock);
+    if (findPackIcon(name) >= 0) {
+        return RESOURCE_ICON_PREFIX + "/" + name;
+    }
+    return QString();
+}
+
+QPixmap QWinUIIconManager::placeholderIcon(const RasterKey& key, const QSize& size, const QColor& color, qreal devicePixelRatio) const
+{
+    // 调用方需持有 m_packLock 读锁
+    // 在已缓存的同一图标中找设备像素尺寸最接近的一项
+    const QSize targetPixels = size * devicePixelRatio;
+    QImage bestImage;
+    QImage bestMask;
+    int bestDistance = std::numeric_limits<int>::max();
+
+    for (RasterShard& shard : m_shards) {
+        QMutexLocker locker(&shard.mutex);
+        for (auto it = shard.cache.cbegin(); it != shard.cache.cend(); ++it) {
+            const RasterKey& candidate = it.key();
+            if (candidate.colorize != key.colorize || candidate.source != key.source) {
+                continue;
+            }
+
+            const QSize pixels = candidate.size * (candidate.dprPercent / 100.0);
+            const int distance = qAbs(pixels.width() - targetPixels.width())
+                               + qAbs(pixels.height() - targetPixels.height());
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                bestImage = it.value()->item.image;
+                bestMask = it.value()->item.mask;
+            }
+        }
+    }
+
+    QPixmap placeholder;
+    if (!bestMask.isNull()) {
+        placeholder = QPixmap::fromImage(tintAlphaMask(bestMask, color)
+                                             .scaled(targetPixels, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    } else if (!bestImage.isNull()) {
+        placeholder = QPixmap::fromImage(bestImage.scaled(targetPixels, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    } else {
+        placeholder = QPixmap(targetPixels);
+        placeholder.fill(Qt::transparent);
+    }
+    placeholder.setDevicePixelRatio(devicePixelRatio);
+    return placeholder;
+}
+
+void QWinUIIconManager::queueAsyncRaster(const QString& filePath, const RasterKey& key, const QSize& size, qreal devicePixelRatio) const
+{
+    {
+        QMutexLocker locker(&m_asyncMutex);
+        if (m_asyncKeys.contains(key)) {
+            return;
+        }
+
+        AsyncJob job;
+        job.key = key;
+        job.filePath = filePath;
+        job.size = size;
+        job.devicePixelRatio = devicePixelRatio;
+        m_asyncKeys.insert(key);
+        m_asyncQueue.append(job);
+    }
+    startAsyncJobs();
+}
+
+void QWinUIIconManager::startAsyncJobs() const
+{
+    QWinUIIconManager* self = const_cast<QWinUIIconManager*>(this);
+
+    QMutexLocker locker(&m_asyncMutex);
+    while (m_asyncRunning < m_maxAsyncJobs && !m_asyncQueue.isEmpty()) {
+        // 后进先出：最近请求的图标最可能仍然可见
+        const AsyncJob job = m_asyncQueue.takeLast();
+        ++m_asyncRunning;
+
+        m_asyncPool.start([self, job]() {
+            QImage image;
+            {
+                QReadLocker packLocker(&self->m_packLock);
+                image = self->rasterize(job.filePath, job.size, job.devicePixelRatio, job.key.colorize);
+                // 预光栅化遮罩引用图标包的映射内存，离开读锁前复制
+                if (self->isPackBacked(image)) {
+                    image = image.copy();
+                }
+            }
+
+            // iconReady 在管理器所在线程发出，接收方在那里创建 QPixmap
+            QMetaObject::invokeMethod(self, [self, job, image]() {
+                self->finishAsyncJob(job, image);
+            }, Qt::QueuedConnection);
+        });
+    }
+}
+
+void QWinUIIconManager::finishAsyncJob(const AsyncJob& job, const QImage& image)
+{
+    {
+        QMutexLocker locker(&m_asyncMutex);
+        m_asyncKeys.remove(job.key);
+        --m_asyncRunning;
+    }
+
+    // 结果随信号交给等待的控件，不依赖之后再查一次缓存
+    QImage result;
+    if (!image.isNull()) {
+        {
+            QReadLocker packLocker(&m_packLock);
+            RasterShard& shard = shardFor(job.key);
+            QMutexLocker locker(&shard.mutex);
+            // 同步路径可能已经写入了同一个键
+            const RasterNode* node = shard.cache.value(job.key, nullptr);
+            if (!node) {
+                node = insertRasterNode(shard, job.key, image, job.size);
+            }
+            result = job.key.colorize ? node->item.mask : node->item.image;
+            // 同步路径写入的预光栅化遮罩引用图标包的映射内存，接收方可能一直持有
+            // 或经排队连接在卸载图标包之后才收到，发出深拷贝
+            if (isPackBacked(result)) {
+                result = result.copy();
+            }
+        }
+        cleanupCache(&job.key);
+    }
+
+    startAsyncJobs();
+
+    if (!result.isNull()) {
+        emit iconReady(job.filePath, job.size, job.devicePixelRatio, result);
+    }
+}
+
+QImage QWinUIIconManager::rasterize(const QString& filePath, const QSize& size, qreal devicePixelRatio, bool colorize) const
+{
+    // 调用方需持有 m_packLock 读锁
+    const int packIndex = packIndexForPath(filePath);
+    if (packIndex >= 0) {
+        // 图标包中的图标直接按预解析的路径绘制，不需要文档锁
+        QImage image = renderPackIcon(packIndex, size, devicePixelRatio);
+        // 预光栅化遮罩没有颜色信息，未着色请求按SVG默认的黑色填充
+        if (!colorize && image.format() == QImage::Format_Alpha8) {
+            image = tintAlphaMask(image, Qt::black);
+        }
+        return image;
+    }
+
+    // 不同尺寸和颜色共享同一份解析后的文档
+    QMutexLocker locker(&m_documentMutex);
+    QSvgRenderer* renderer = getDocument(filePath);
+    if (!renderer) {
+        return QImage();
+    }
+
+    // 按设备像素渲染图标，避免高DPI屏幕上被放大模糊
+    QImage image(size * devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(devicePixelRatio);
+    image.fill(Qt::transparent);
+
+    {
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing);
+        renderer->render(&painter, QRectF(QPointF(0, 0), QSizeF(size)));
+    }
+    return image;
+}
+
+QWinUIIconVector QWinUIIconManager::getIconVector(const QString& name) const
+{
+    const QString filePath = iconFilePath(name);
+    if (filePath.isEmpty()) {
+        qWarning() << "Icon not found:" << name;
+        return QWinUIIconVector();
+    }
+    return getIconVectorFromFile(filePath);
+}
+
+QWinUIIconVector QWinUIIconManager::getIconVectorFromFile(const QString& filePath) const
+{
+    if (filePath.isEmpty()) {
+        return QWinUIIconVector();
+    }
+
+    QReadLocker packLocker(&m_packLock);
+    QMutexLocker locker(&m_documentMutex);
+    if (const QWinUIIconVector* cached = m_vectors.object(filePath)) {
+        return *cached;
+    }
+
+    QWinUIIconVector* vector = extractVector(filePath);
+    if (!vector) {
+        return QWinUIIconVector();
+    }
+
+    const QWinUIIconVector result = *vector;
+    m_vectors.insert(filePath, vector);
+    return result;
+}
+
+void QWinUIIconManager::drawIconVector(QPainter* painter, const QWinUIIconVector& vector, const QRectF& target, const QColor& color)
+{
+    if (!painter || !vector.isValid() || target.isEmpty()) {
+        return;
+    }
+
+    painter->save();
+    painter->translate(target.topLeft());
+    painter->scale(target.width() / vector.size.width(), target.height() / vector.size.height());
+    const QTransform base = painter->transform();
+    const qreal baseOpacity = painter->opacity();
+
+    for (const QWinUIIconVectorLayer& layer : vector.layers) {
+        QBrush brush = layer.brush;
+        QPen pen = layer.pen;
+        if (color.isValid()) {
+            // 与 tintAlphaMask 一致：替换颜色，保留原有的透明度
+            if (brush.style() != Qt::NoBrush) {
+                QColor tinted = color;
+                tinted.setAlphaF(color.alphaF() * brush.color().alphaF());
+                brush = QBrush(tinted);
+            }
+            if (pen.style() != Qt::NoPen) {
+                QColor tinted = color;
+                tinted.setAlphaF(color.alphaF() * pen.color().alphaF());
+                pen.setBrush(tinted);
+            }
+        }
+
+        painter->setTransform(layer.transform * base);
+        painter->setOpacity(baseOpacity * layer.opacity);
+        painter->setBrush(brush);
+        painter->setPen(pen);
+        painter->drawPath(layer.path);
+    }
+
+    painter->restore();
+}
+
+namespace {
+
+// 记录 QSvgRenderer 绘制命令的绘图引擎：每次填充或描边保存为一个图层，位图内容不记录
+class IconVectorPaintEngine : public QPaintEngine
+{
+public:
+    explicit IconVectorPaintEngine(QList<QWinUIIconVectorLayer>* layers)
+        : QPaintEngine(QPaintEngine::AllFeatures)
+        , m_layers(layers)
+        , m_opacity(1.0)
+    {
+    }
+
+    bool begin(QPaintDevice*) override { return true; }
+    bool end() override { return true; }
+    Type type() const override { return QPaintEngine::User; }
+
+    void updateState(const QPaintEngineState& state) override
+    {
+        const QPaintEngine::DirtyFlags flags = state.state();
+        if (flags & DirtyTransform) {
+            m_transform = state.transform();
+        }
+        if (flags & DirtyBrush) {
+            m_brush = state.brush();
+        }
+        if (flags & DirtyPen) {
+            m_pen = state.pen();
+        }
+        if (flags & DirtyOpacity) {
+            m_opacity = state.opacity();
+        }
+    }
+
+    void drawPath(const QPainterPath& path) override
+    {
+        record(path, m_brush);
+    }
+
+    void drawPolygon(const QPointF* points, int pointCount, PolygonDrawMode mode) override
+    {
+        QPainterPath path;
+        path.addPolygon(QPolygonF(QList<QPointF>(points, points + pointCount)));
+        if (mode == PolylineMode) {
+            record(path, Qt::NoBrush);
+            return;
+        }
+        path.closeSubpath();
+        path.setFillRule(mode == WindingMode ? Qt::WindingFill : Qt::OddEvenFill);
+        record(path, m_brush);
+    }
+
+    void drawPixmap(const QRectF&, const QPixmap&, const QRectF&) override
+    {
+    }
+
+private:
+    void record(const QPainterPath& path, const QBrush& brush)
+    {
+        if (path.isEmpty() || (brush.style() == Qt::NoBrush && m_pen.style() == Qt::NoPen)) {
+            return;
+        }
+
+        QWinUIIconVectorLayer layer;
+        layer.path = path;
+        layer.brush = brush;
+        layer.pen = m_pen;
+        layer.transform = m_transform;
+        layer.opacity = m_opacity;
+        m_layers->append(layer);
+    }
+
+    QList<QWinUIIconVectorLayer>* m_layers;
+    QTransform m_transform;
+    QBrush m_brush;
+    QPen m_pen;
+    qreal m_opacity;
+};
+
+class IconVectorDevice : public QPaintDevice
+{
+public:
+    explicit IconVectorDevice(const QSize& size)
+        : m_engine(&m_layers)
+        , m_size(size)
+    {
+    }
+
+    QPaintEngine* paintEngine() const override
+    {
+        return const_cast<IconVectorPaintEngine*>(&m_engine);
+    }
+
+    QList<QWinUIIconVectorLayer> layers() const
+    {
+        return m_layers;
+    }
+
+protected:
+    int metric(PaintDeviceMetric metric) const override
+    {
+        switch (metric) {
+        case PdmWidth:
+            return m_size.width();
+        case PdmHeight:
+            return m_size.height();
+        case PdmWidthMM:
+            return qRound(m_size.width() * 25.4 / 96.0);
+        case PdmHeightMM:
+            return qRound(m_size.height() * 25.4 / 96.0);
+        case PdmDpiX:
+        case PdmDpiY:
+        case PdmPhysicalDpiX:
+        case PdmPhysicalDpiY:
+            return 96;
+        case PdmDepth:
+            return 32;
+        case PdmNumColors:
+            return std::numeric_limits<int>::max();
+        default:
+            return QPaintDevice::metric(metric);
+        }
+    }
+
+private:
+    QList<QWinUIIconVectorLayer> m_layers;
+    IconVectorPaintEngine m_engine;
+    QSize m_size;
+};
+
+} // namespace
+
+QWinUIIconVector* QWinUIIconManager::extractVector(const QString& filePath) const
+{
+    const int packIndex = packIndexForPath(filePath);
+    if (packIndex >= 0) {
+        // 图标包中的图标只有一条按SVG默认黑色填充的路径
+        const QRectF viewBox = packIconViewBox(packIndex);
+        if (viewBox.isEmpty()) {
+            return nullptr;
+        }
+
+        QWinUIIconVectorLayer layer;
+        layer.path = packIconPath(packIndex);
+        layer.brush = QBrush(Qt::black);
+        layer.pen = QPen(Qt::NoPen);
+        layer.transform = QTransform::fromTranslate(-viewBox.x(), -viewBox.y());
+
+        QWinUIIconVector* vector = new QWinUIIconVector();
+        vector->size = viewBox.size();
+        vector->layers.append(layer);
+        return vector;
+    }
+
+    QSvgRenderer* renderer = getDocument(filePath);
+    if (!renderer) {
+        return nullptr;
+    }
+
+    // 按 viewBox 尺寸绘制一遍，记录下每个图层的路径、画刷、画笔和变换
+    QSizeF size = renderer->viewBoxF().size();
+    if (size.isEmpty()) {
+        size = renderer->defaultSize();
+    }
+    if (size.isEmpty()) {
+        return nullptr;
+    }
+
+    IconVectorDevice device(size.toSize().expandedTo(QSize(1, 1)));
+    {
+        QPainter painter(&device);
+        renderer->render(&painter, QRectF(QPointF(0, 0), size));
+    }
+
+    QWinUIIconVector* vector = new QWinUIIconVector();
+    vector->size = size;
+    vector->layers = device.layers();
+    return vector;
+}
+
+QSvgRenderer* QWinUIIconManager::getDocument(const QString& filePath) const
+{
+    if (QSvgRenderer* renderer = m_documents.object(filePath)) {
+        ++m_documentHits;
+        return renderer;
+    }
+    ++m_documentMisses;
+
+    QSvgRenderer* renderer = new QSvgRenderer(filePath);
+    if (!renderer->isValid()) {
+        delete renderer;
+        return nullptr;
+    }
+
+    // 插入后 QCache 可能淘汰其他文档，但不会淘汰刚插入的这一项
+    m_documents.insert(filePath, renderer);
+    return renderer;
+}
+
+int QWinUIIconManager::findPackIcon(const QString& name) const
+{
+    if (!m_packData || name.isEmpty()) {
+        return -1;
+    }
+
+    const QByteArray key = name.toUtf8();
+    const IconPackHeader* header = packHeader(m_packData);
+    const quint32_le* buckets = reinterpret_cast<const quint32_le*>(m_packData + header->bucketsOffset);
+    const quint32 mask = header->bucketCount - 1;
+    const quint32 iconCount = header->iconCount;
+
+    // 线性探测，装载因子不超过0.5
+    quint32 slot = iconPackHash(key) & mask;
+    for (quint32 probe = 0; probe <= mask; ++probe, slot = (slot + 1) & mask) {
+        const quint32 value = buckets[slot];
+        if (value == 0 || value > iconCount) {
+            return -1;
+        }
+
+        const IconPackEntry& entry = packEntry(m_packData, int(value - 1));
+        if (packString(m_packData, entry.nameOffset, entry.nameLength) == QByteArrayView(key)) {
+            return int(value - 1);
+        }
+    }
+    return -1;
+}
+
+int QWinUIIconManager::packIndexForPath(const QString& filePath) const
+{
+    // 图标包中的图标以 ":/icons/<名称>" 形式兼容原先的资源路径
+    if (!m_packData || filePath.size() <= RESOURCE_ICON_PREFIX.size()
+        || !filePath.startsWith(RESOURCE_ICON_PREFIX) || filePath.at(RESOURCE_ICON_PREFIX.size()) != '/') {
+        return -1;
+    }
+    return findPackIcon(filePath.mid(RESOURCE_ICON_PREFIX.size() + 1));
+}
+
+QString QWinUIIconManager::packIconName(int index) const
+{
+    const IconPackEntry& entry = packEntry(m_packData, index);
+    return QString::fromUtf8(packString(m_packData, entry.nameOffset, entry.nameLength));
+}
+
+QString QWinUIIconManager::packIconCategory(int index) const
+{
+    const IconPackEntry& entry = packEntry(m_packData, index);
+    return QString::fromUtf8(packString(m_packData, entry.categoryOffset, entry.categoryLength));
+}
+
+QRectF QWinUIIconManager::packIconViewBox(int index) const
+{
+    const IconPackEntry& entry = packEntry(m_packData, index);
+    return QRectF(qFromLittleEndian<float>(&entry.viewBox[0]), qFromLittleEndian<float>(&entry.viewBox[1]),
+                  qFromLittleEndian<float>(&entry.viewBox[2]), qFromLittleEndian<float>(&entry.viewBox[3]));
+}
+
+QPainterPath QWinUIIconManager::packIconPath(int index) const
+{
+    QPainterPath path;
+    path.setFillRule(Qt::WindingFill); // SVG默认的非零环绕规则
+
+    const IconPackHeader* header = packHeader(m_packData);
+    const IconPackEntry& entry = packEntry(m_packData, index);
+    const quint64 commandSection = header->coordsOffset - header->commandsOffset;
+    const quint64 coordSection = (header->rastersOffset - header->coordsOffset) / sizeof(float);
+    if (quint64(entry.commandOffset) + entry.commandCount > commandSection
+        || quint64(entry.coordOffset) + entry.coordCount > coordSection) {
+        qWarning() << "Corrupted icon pack entry:" << packIconName(index);
+        return path;
+    }
+
+    const uchar* commands = m_packData + header->commandsOffset + entry.commandOffset;
+    const uchar* coords = m_packData + header->coordsOffset + quint64(entry.coordOffset) * sizeof(float);
+    const quint32 commandCount = entry.commandCount;
+    const quint32 coordCount = entry.coordCount;
+    quint32 used = 0;
+
+    auto coord = [&](int i) {
+        return qreal(qFromLittleEndian<float>(coords + (used + i) * sizeof(float)));
+    };
+
+    for (quint32 i = 0; i < commandCount; ++i) {
+        const uchar command = commands[i];
+        const quint32 needed = command == PackCubicTo ? 6 : (command == PackClose ? 0 : 2);
+        if (command > PackClose || used + needed > coordCount) {
+            qWarning() << "Corrupted icon pack entry:" << packIconName(index);
+            break;
+        }
+
+        switch (command) {
+        case PackMoveTo:
+            path.moveTo(coord(0), coord(1));
+            break;
+        case PackLineTo:
+            path.lineTo(coord(0), coord(1));
+            break;
+        case PackCubicTo:
+            path.cubicTo(coord(0), coord(1), coord(2), coord(3), coord(4), coord(5));
+            break;
+        case PackClose:
+            path.closeSubpath();
+            break;
+        }
+        used += needed;
+    }
+
+    return path;
+}
+
+QImage QWinUIIconManager::packIconRaster(int index, int pixelSize) const
+{
+    const IconPackHeader* header = packHeader(m_packData);
+    const IconPackEntry& entry = packEntry(m_packData, index);
+    if (entry.rasterOffset == 0) {
+        return QImage();
+    }
+
+    quint64 offset = entry.rasterOffset;
+    for (int i = 0; i < header->rasterSizeCount; ++i) {
+        const int size = header->rasterSizes[i];
+        const int stride = packRasterStride(size);
+        const quint64 bytes = quint64(stride) * size;
+        if (size == pixelSize) {
+            if (offset < header->rastersOffset || offset + bytes > quint64(m_packSize)) {
+                return QImage();
+            }
+            // 直接引用映射内存，不复制像素
+            return QImage(m_packData + offset, size, size, stride, QImage::Format_Alpha8);
+        }
+        offset += bytes;
+    }
+    return QImage();
+}
+
+QImage QWinUIIconManager::renderPackIcon(int index, const QSize& size, qreal devicePixelRatio) const
+{
+    const QSize pixelSize = size * devicePixelRatio;
+
+    // 命中预光栅化尺寸时直接使用图标包中的遮罩
+    if (pixelSize.width() == pixelSize.height()) {
+        QImage mask = packIconRaster(index, pixelSize.width());
+        if (!mask.isNull()) {
+            mask.setDevicePixelRatio(devicePixelRatio);
+            return mask;
+        }
+    }
+
+    QImage image(pixelSize, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(devicePixelRatio);
+    image.fill(Qt::transparent);
+
+    const QRectF viewBox = packIconViewBox(index);
+    if (viewBox.isEmpty()) {
+        return image;
+    }
+
+    // 与 QSvgRenderer 默认行为一致，viewBox 拉伸到目标区域
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.scale(size.width() / viewBox.width(), size.height() / viewBox.height());
+    painter.translate(-viewBox.topLeft());
+    painter.fillPath(packIconPath(index), Qt::black);
+    return image;
+}
+
+bool QWinUIIconManager::isPackBacked(const QImage& image) const
+{
+    if (!m_packData || image.isNull()) {
+        return false;
+    }
+    const uchar* bits = image.constBits();
+    return bits >= m_packData && bits < m_packData + m_packSize;
+}
+
+QByteArray QWinUIIconManager::packIconSvgData(int index) const
+{
+    const QRectF viewBox = packIconViewBox(index);
+    const QPainterPath path = packIconPath(index);
+
+    auto number = [](qreal value) { return QByteArray::number(value, 'g', 7); };
+
+    QByteArray data = "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\""
+        + number(viewBox.x()) + ' ' + number(viewBox.y()) + ' '
+        + number(viewBox.width()) + ' ' + number(viewBox.height()) + "\"><path d=\"";
+
+    for (int i = 0; i < path.elementCount(); ++i) {
+        const QPainterPath::Element element = path.elementAt(i);
+        switch (element.type) {
+        case QPainterPath::MoveToElement:
+            data += 'M';
+            break;
+        case QPainterPath::LineToElement:
+            data += 'L';
+            break;
+        case QPainterPath::CurveToElement:
+            data += 'C';
+            break;
+        case QPainterPath::CurveToDataElement:
+            data += ' ';
+            break;
+        }
+        data += number(element.x) + ' ' + number(element.y);
+    }
+
+    data += "\"/></svg>";
+    return data;
+}
+
+QSvgRenderer* QWinUIIconManager::getRenderer(const QString& name) const
+{
+    QString filePath;
+    {
+        QReadLocker locker(&m_registryLock);
+        auto it = m_icons.constFind(name);
+        if (it != m_icons.constEnd()) {
+            filePath = it->filePath;
+        }
+    }
+    if (!filePath.isEmpty()) {
+        return new QSvgRenderer(filePath);
+    }
+    
+    QReadLocker packLocker(&m_packLock);
+    const int index = findPackIcon(name);
+    if (index >= 0) {
+        return new QSvgRenderer(packIconSvgData(index));
+    }
+    return nullptr;
+}
+
+bool QWinUIIconManager::hasIconFile(const QString& filePath) const
+{
+    {
+        QReadLocker packLocker(&m_packLock);
+        if (packIndexForPath(filePath) >= 0) {
+            return true;
+        }
+    }
+    return QFile::exists(filePath);
+}
+
+QByteArray QWinUIIconManager::getIconData(const QString& filePath) const
+{
+    {
+        QReadLocker packLocker(&m_packLock);
+        const int index = packIndexForPath(filePath);
+        if (index >= 0) {
+            return packIconSvgData(index);
+        }
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void QWinUIIconManager::clearCache()
+{
+    clearRasterCache();
+    {
+        QMutexLocker locker(&m_documentMutex);
+        m_documents.clear();
+        m_vectors.clear();
+    }
+    {
+        QMutexLocker locker(&m_glyphMutex);
+        m_glyphPaths.clear();
+    }
+    emit cacheCleared();
+}
+
+void QWinUIIconManager::clearCache(const QString& name)
+{
+    const QString filePath = getIconInfo(name).filePath;
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_documentMutex);
+        m_documents.remove(filePath);
+        m_vectors.remove(filePath);
+    }
+
+    for (RasterShard& shard : m_shards) {
+        QMutexLocker locker(&shard.mutex);
+        auto it = shard.cache.begin();
+        while (it != shard.cache.end()) {
+            if (it.key().source == filePath) {
+                RasterNode* node = it.value();
+                it = shard.cache.erase(it);
+                unlinkRasterNode(shard, node);
+                m_rasterCount.fetch_sub(1, std::memory_order_relaxed);
+                m_rasterBytes.fetch_sub(node->item.byteSize, std::memory_order_relaxed);
+                delete node;
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void QWinUIIconManager::setCacheLimit(int maxItems)
+{
+    m_cacheLimit = qMax(10, maxItems);
+    cleanupCache();
+}
+
+int QWinUIIconManager::getCacheSize() const
+{
+    return m_rasterCount.load(std::memory_order_relaxed);
+}
+
+void QWinUIIconManager::setCacheByteLimit(qint64 maxBytes)
+{
+    m_cacheByteLimit = qMax<qint64>(64 * 1024, maxBytes);
+    cleanupCache();
+}
+
+qint64 QWinUIIconManager::getCacheByteLimit() const
+{
+    return m_cacheByteLimit;
+}
+
+qint64 QWinUIIconManager::getCacheBytes() const
+{
+    return m_rasterBytes.load(std::memory_order_relaxed);
+}
+
+void QWinUIIconManager::setDocumentCacheLimit(int maxDocuments)
+{
+    QMutexLocker locker(&m_documentMutex);
+    m_documents.setMaxCost(qMax(1, maxDocuments));
+    m_vectors.setMaxCost(qMax(1, maxDocuments));
+}
+
+int QWinUIIconManager::getDocumentCacheSize() const
+{
+    QMutexLocker locker(&m_documentMutex);
+    return m_documents.size();
+}
+
+QWinUIIconCacheStats QWinUIIconManager::getCacheStats() const
+{
+    QWinUIIconCacheStats stats;
+    {
+        QMutexLocker locker(&m_documentMutex);
+        stats.documentHits = m_documentHits;
+        stats.documentMisses = m_documentMisses;
+        stats.documentCount = m_documents.size();
+    }
+
+    for (RasterShard& shard : m_shards) {
+        QMutexLocker locker(&shard.mutex);
+        stats.rasterHits += shard.hits;
+        stats.rasterMisses += shard.misses;
+        stats.rasterEvictions += shard.evictions;
+        stats.rasterWaits += shard.waits;
+    }
+    stats.rasterCount = m_rasterCount.load(std::memory_order_relaxed);
+    stats.rasterBytes = m_rasterBytes.load(std::memory_order_relaxed);
+    stats.rasterByteLimit = m_cacheByteLimit;
+    return stats;
+}
+
+void QWinUIIconManager::resetCacheStats()
+{
+    {
+        QMutexLocker locker(&m_documentMutex);
+        m_documentHits = 0;
+        m_documentMisses = 0;
+    }
+
+    for (RasterShard& shard : m_shards) {
+        QMutexLocker locker(&shard.mutex);
+        shard.hits = 0;
+        shard.misses = 0;
+        shard.evictions = 0;
+        shard.waits = 0;
+    }
+}
+
+QPixmap QWinUIIconManager::colorizePixmap(const QPixmap& pixmap, const QColor& color)
+{
+    if (pixmap.isNull() || !color.isValid()) {
+        return pixmap;
+    }
+    
+    // 等价于 CompositionMode_SourceIn 填充：结果 = 颜色 × 原图alpha
+    return QPixmap::fromImage(tintAlphaMask(pixmap.toImage(), color));
+}
+
+QImage QWinUIIconManager::tintAlphaMask(const QImage& mask, const QColor& color)
+{
+    if (mask.isNull() || !color.isValid()) {
+        return QImage();
+    }
+
+    const QImage alpha = mask.format() == QImage::Format_Alpha8
+        ? mask
+        : mask.convertToFormat(QImage::Format_Alpha8);
+
+    QImage result(alpha.size(), QImage::Format_ARGB32_Premultiplied);
+    result.setDevicePixelRatio(alpha.devicePixelRatio());
+
+    const quint32 premulColor = qPremultiply(color.rgba());
+    const int width = alpha.width();
+    for (int y = 0; y < alpha.height(); ++y) {
+        tintAlphaRow(alpha.constScanLine(y), reinterpret_cast<quint32*>(result.scanLine(y)), width, premulColor);
+    }
+    return result;
+}
+
+QString QWinUIIconManager::getIconNameFromPath(const QString& filePath)
+{
+    QFileInfo fileInfo(filePath);
+    return fileInfo.baseName();
+}
+
+QWinUIIconManager::RasterShard& QWinUIIconManager::shardFor(const RasterKey& key) const
+{
+    static_assert((RASTER_SHARD_COUNT & (RASTER_SHARD_COUNT - 1)) == 0, "Shard count must be a power of two");
+    return m_shards[qHash(key, 0) & (RASTER_SHARD_COUNT - 1)];
+}
+
+QWinUIIconManager::RasterNode* QWinUIIconManager::touchRasterNode(RasterShard& shard, const RasterKey& key) const
+{
+    auto cached = shard.cache.constFind(key);
+    if (cached == shard.cache.constEnd()) {
+        return nullptr;
+    }
+
+    ++shard.hits;
+    RasterNode* node = cached.value();
+    // 移到链表头部
+    node->lastUse = m_rasterClock.fetch_add(1, std::memory_order_relaxed) + 1;
+    unlinkRasterNode(shard, node);
+    linkRasterNode(shard, node);
+    return node;
+}
+
+QWinUIIconManager::RasterNode* QWinUIIconManager::insertRasterNode(RasterShard& shard, const RasterKey& key, const QImage& image, const QSize& size) const
+{
+    // 着色请求只保留alpha通道，每像素1字节
+    RasterNode* node = new RasterNode();
+    node->key = key;
+    QWinUIIconCacheItem& item = node->item;
+    if (key.colorize) {
+        item.mask = image.convertToFormat(QImage::Format_Alpha8);
+        item.byteSize = item.mask.sizeInBytes();
+    } else {
+        item.image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        item.byteSize = item.image.sizeInBytes();
+    }
+    item.lastSize = size;
+    node->lastUse = m_rasterClock.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    shard.cache.insert(key, node);
+    linkRasterNode(shard, node);
+    m_rasterCount.fetch_add(1, std::memory_order_relaxed);
+    m_rasterBytes.fetch_add(item.byteSize, std::memory_order_relaxed);
+    return node;
+}
+
+void QWinUIIconManager::removeRasterNode(RasterShard& shard, RasterNode* node) const
+{
+    unlinkRasterNode(shard, node);
+    shard.cache.remove(node->key);
+    m_rasterCount.fetch_sub(1, std::memory_order_relaxed);
+    m_rasterBytes.fetch_sub(node->item.byteSize, std::memory_order_relaxed);
+    delete node;
+}
+
+void QWinUIIconManager::linkRasterNode(RasterShard& shard, RasterNode* node) const
+{
+    node->prev = nullptr;
+    node->next = shard.lruHead;
+    if (shard.lruHead) {
+        shard.lruHead->prev = node;
+    }
+    shard.lruHead = node;
+    if (!shard.lruTail) {
+        shard.lruTail = node;
+    }
+}
+
+void QWinUIIconManager::unlinkRasterNode(RasterShard& shard, RasterNode* node) const
+{
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        shard.lruHead = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        shard.lruTail = node->prev;
+    }
+    node->prev = nullptr;
+    node->next = nullptr;
+}
+
+void QWinUIIconManager::clearRasterCache(RasterShard& shard) const
+{
+    qint64 bytes = 0;
+    for (const RasterNode* node : std::as_const(shard.cache)) {
+        bytes += node->item.byteSize;
+    }
+    m_rasterCount.fetch_sub(int(shard.cache.size()), std::memory_order_relaxed);
+    m_rasterBytes.fetch_sub(bytes, std::memory_order_relaxed);
+
+    qDeleteAll(shard.cache);
+    shard.cache.clear();
+    shard.lruHead = nullptr;
+    shard.lruTail = nullptr;
+}
+
+void QWinUIIconManager::clearRasterCache() const
+{
+    for (RasterShard& shard : m_shards) {
+        QMutexLocker locker(&shard.mutex);
+        clearRasterCache(shard);
+    }
+}
+
+void QWinUIIconManager::cleanupCache(const RasterKey* keep) const
+{
+    // 分片表尾（跳过 keep）即该分片最久未使用的项
+    auto evictable = [keep](const RasterShard& shard) -> RasterNode* {
+        RasterNode* node = shard.lruTail;
+        if (node && keep && node->key == *keep) {
+            node = node->prev;
+        }
+        return node;
+    };
+
+    // 每次在所有分片的表尾中淘汰访问序号最小的一项，直到数量和字节数都回到预算以内。
+    // 同一时刻只持有一个分片锁，不会与其他线程的分片锁顺序冲突
+    while (m_rasterCount.load(std::memory_order_relaxed) > m_cacheLimit
+           || m_rasterBytes.load(std::memory_order_relaxed) > m_cacheByteLimit) {
+        RasterShard* coldest = nullptr;
+        quint64 oldest = std::numeric_limits<quint64>::max();
+        for (RasterShard& shard : m_shards) {
+            QMutexLocker locker(&shard.mutex);
+            const RasterNode* node = evictable(shard);
+            if (node && node->lastUse < oldest) {
+                oldest = node->lastUse;
+                coldest = &shard;
+            }
+        }
+        if (!coldest) {
+            break; // 只剩下 keep 一项
+        }
+
+        // 选中后到重新加锁之间表尾可能已被访问或淘汰，按当前表尾处理，预算判断在下一轮重新进行
+        QMutexLocker locker(&coldest->mutex);
+        if (RasterNode* node = evictable(*coldest)) {
+            removeRasterNode(*coldest, node);
+            ++coldest->evictions;
+        }
     }
 }
 
-QString QWinUIIconManager::getCacheKey(const QString& name, const QSize& size, const QColor& color) const
+QWinUIIconManager::RasterKey QWinUIIconManager::getCacheKey(const QString& filePath, const QSize& size, bool colorize, qreal devicePixelRatio) const
 {
-    return QString("%1|%2x%3|%4").arg(name).arg(size.width()).arg(size.height()).arg(color.name());
+    RasterKey key;
+    key.source = filePath;
+    key.size = size;
+    key.colorize = colorize;
+    key.dprPercent = qRound(devicePixelRatio * 100);
+    return key;
 }
 
 QT_END_NAMESPACE
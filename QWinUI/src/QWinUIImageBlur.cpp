@@ -0,0 +1,280 @@
+#include "QWinUIImageBlur.h"
+#include <QSemaphore>
+#include <QThreadPool>
+#include <QVarLengthArray>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define QWINUI_IMAGE_BLUR_SSE2
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// 除以窗口宽度改为乘以 ceil(65536 / d) 再右移16位；
+// 累加和不超过 255 × d，结果不会超过255
+inline quint32 boxMultiplier(int radius)
+{
+    const quint32 window = quint32(radius) * 2 + 1;
+    return (65536u + window - 1) / window;
+}
+
+} // namespace
+
+int QWinUIImageBlur::downsampleFactor(qreal radius, qreal devicePixelRatio)
+{
+    // 小图上的 sigma 保持在3像素左右，放大后的插值误差不明显
+    const qreal sigma = radius * devicePixelRatio / 3.0;
+    return qBound(1, int(sigma / 3.0), 16);
+}
+
+QImage QWinUIImageBlur::blur(const QImage& image, qreal radius)
+{
+    if (image.isNull()) {
+        return QImage();
+    }
+
+    QImage source = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    const qreal dpr = image.devicePixelRatio();
+    const qreal sigma = radius * dpr / 3.0;
+    if (sigma < 0.5) {
+        return source;
+    }
+
+    const int factor = downsampleFactor(radius, dpr);
+    QImage work = factor > 1 ? downsample(source, factor) : source;
+
+    // 三次盒式模糊近似高斯：每次的窗口宽度 w 满足 3 × (w² - 1) / 12 = sigma²
+    const qreal scaledSigma = sigma / factor;
+    const qreal idealWidth = std::sqrt(12.0 * scaledSigma * scaledSigma / 3.0 + 1.0);
+    const int boxRadius = qBound(0, qRound((idealWidth - 1.0) / 2.0), MAX_BOX_RADIUS);
+    if (boxRadius > 0) {
+        for (int pass = 0; pass < 3; ++pass) {
+            boxBlurHorizontal(work, boxRadius);
+            boxBlurVertical(work, boxRadius);
+        }
+    }
+
+    if (factor > 1) {
+        // 放大到整数倍再裁剪，各像素的采样位置只取决于它在整图中的坐标
+        work = work.scaled(work.size() * factor, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                   .copy(source.rect())
+                   .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    }
+    work.setDevicePixelRatio(dpr);
+    return work;
+}
+
+QImage QWinUIImageBlur::downsample(const QImage& image, int factor)
+{
+    // 按 factor × factor 的块取平均（边缘的块按实际像素数平均）
+    const int width = image.width();
+    const int height = image.height();
+    QImage result((width + factor - 1) / factor, (height + factor - 1) / factor, QImage::Format_ARGB32_Premultiplied);
+    const int resultWidth = result.width();
+
+    parallelFor(result.height(), qint64(width) * factor, [&](int firstRow, int lastRow) {
+        QVarLengthArray<quint32, 1024> sums(resultWidth * 4);
+        for (int y = firstRow; y < lastRow; ++y) {
+            std::fill(sums.begin(), sums.end(), 0u);
+            const int top = y * factor;
+            const int rows = qMin(factor, height - top);
+            for (int row = 0; row < rows; ++row) {
+                const uchar* line = image.constScanLine(top + row);
+                for (int x = 0; x < width; ++x) {
+                    quint32* sum = sums.data() + (x / factor) * 4;
+                    sum[0] += line[x * 4];
+                    sum[1] += line[x * 4 + 1];
+                    sum[2] += line[x * 4 + 2];
+                    sum[3] += line[x * 4 + 3];
+                }
+            }
+
+            uchar* out = result.scanLine(y);
+            for (int x = 0; x < resultWidth; ++x) {
+                const quint32 count = quint32(rows * qMin(factor, width - x * factor));
+                for (int c = 0; c < 4; ++c) {
+                    out[x * 4 + c] = uchar((sums[x * 4 + c] + count / 2) / count);
+                }
+            }
+        }
+    });
+    return result;
+}
+
+void QWinUIImageBlur::boxBlurHorizontal(QImage& image, int radius)
+{
+    uchar* bits = image.bits();
+    const qsizetype stride = image.bytesPerLine();
+    const int width = image.width();
+    parallelFor(image.height(), width, [&](int firstRow, int lastRow) {
+        boxBlurRows(bits, stride, width, firstRow, lastRow, radius);
+    });
+}
+
+void QWinUIImageBlur::boxBlurVertical(QImage& image, int radius)
+{
+    uchar* bits = image.bits();
+    const qsizetype stride = image.bytesPerLine();
+    const int height = image.height();
+    parallelFor(image.width(), height, [&](int firstColumn, int lastColumn) {
+        boxBlurColumns(bits, stride, height, firstColumn, lastColumn, radius);
+    });
+}
+
+void QWinUIImageBlur::boxBlurRows(uchar* bits, qsizetype stride, int width, int firstRow, int lastRow, int radius)
+{
+    const quint32 multiplier = boxMultiplier(radius);
+    QVarLengthArray<quint32, 1024> line(width);
+
+    for (int y = firstRow; y < lastRow; ++y) {
+        quint32* row = reinterpret_cast<quint32*>(bits + y * stride);
+        // 输出会覆盖窗口后部仍需减去的像素，先保留原始行
+        std::memcpy(line.data(), row, size_t(width) * 4);
+        const quint32* pixels = line.constData();
+
+        auto pixelAt = [&](int x) { return pixels[qBound(0, x, width - 1)]; };
+
+#ifdef QWINUI_IMAGE_BLUR_SSE2
+        // 4个通道各占一个16位通道
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i factor = _mm_set1_epi16(short(multiplier));
+        auto unpack = [&](quint32 pixel) { return _mm_unpacklo_epi8(_mm_cvtsi32_si128(int(pixel)), zero); };
+
+        __m128i sum = _mm_mullo_epi16(unpack(pixels[0]), _mm_set1_epi16(short(radius + 1)));
+        for (int i = 1; i <= radius; ++i) {
+            sum = _mm_add_epi16(sum, unpack(pixelAt(i)));
+        }
+        for (int x = 0; x < width; ++x) {
+            const __m128i value = _mm_mulhi_epu16(sum, factor);
+            row[x] = quint32(_mm_cvtsi128_si32(_mm_packus_epi16(value, zero)));
+            sum = _mm_sub_epi16(_mm_add_epi16(sum, unpack(pixelAt(x + radius + 1))), unpack(pixelAt(x - radius)));
+        }
+#else
+        quint32 sum[4];
+        for (int c = 0; c < 4; ++c) {
+            sum[c] = ((pixels[0] >> (c * 8)) & 0xFF) * quint32(radius + 1);
+            for (int i = 1; i <= radius; ++i) {
+                sum[c] += (pixelAt(i) >> (c * 8)) & 0xFF;
+            }
+        }
+        for (int x = 0; x < width; ++x) {
+            quint32 value = 0;
+            const quint32 incoming = pixelAt(x + radius + 1);
+            const quint32 outgoing = pixelAt(x - radius);
+            for (int c = 0; c < 4; ++c) {
+                value |= ((sum[c] * multiplier) >> 16) << (c * 8);
+                sum[c] += ((incoming >> (c * 8)) & 0xFF) - ((outgoing >> (c * 8)) & 0xFF);
+            }
+            row[x] = value;
+        }
+#endif
+    }
+}
+
+void QWinUIImageBlur::boxBlurColumns(uchar* bits, qsizetype stride, int height, int firstColumn, int lastColumn, int radius)
+{
+    // 按整行的一段同时处理所有列：累加和数组随行滑动，内层循环是连续的字节运算
+    const int bytes = (lastColumn - firstColumn) * 4;
+    const quint16 multiplier = quint16(boxMultiplier(radius));
+    uchar* base = bits + firstColumn * 4;
+    auto rowAt = [&](int y) { return base + qBound(0, y, height - 1) * stride; };
+
+    // 输出会覆盖窗口上方仍需减去的行，保留最近 radius + 1 行的原始数据
+    const int ringSize = radius + 1;
+    QVarLengthArray<uchar, 4096> ring(qsizetype(ringSize) * bytes);
+    QVarLengthArray<uchar, 1024> firstRow(bytes);
+    std::memcpy(firstRow.data(), rowAt(0), size_t(bytes));
+
+    QVarLengthArray<quint16, 1024> sums(bytes);
+    for (int i = 0; i < bytes; ++i) {
+        sums[i] = quint16(firstRow[i] * (radius + 1));
+    }
+    for (int y = 1; y <= radius; ++y) {
+        const uchar* row = rowAt(y);
+        for (int i = 0; i < bytes; ++i) {
+            sums[i] = quint16(sums[i] + row[i]);
+        }
+    }
+
+    for (int y = 0; y < height; ++y) {
+        uchar* row = base + y * stride;
+        uchar* saved = ring.data() + qsizetype(y % ringSize) * bytes;
+        std::memcpy(saved, row, size_t(bytes));
+
+        if (y == height - 1) {
+            // 最后一行不需要再滑动窗口
+            for (int i = 0; i < bytes; ++i) {
+                row[i] = uchar((quint32(sums[i]) * multiplier) >> 16);
+            }
+            break;
+        }
+
+        const uchar* incoming = rowAt(y + radius + 1);
+        const uchar* outgoing = y - radius >= 0
+            ? ring.constData() + qsizetype((y - radius) % ringSize) * bytes
+            : firstRow.constData();
+        quint16* sum = sums.data();
+        int i = 0;
+
+#ifdef QWINUI_IMAGE_BLUR_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i factor = _mm_set1_epi16(short(multiplier));
+        for (; i + 16 <= bytes; i += 16) {
+            __m128i sumLow = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sum + i));
+            __m128i sumHigh = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sum + i + 8));
+            const __m128i value = _mm_packus_epi16(_mm_mulhi_epu16(sumLow, factor), _mm_mulhi_epu16(sumHigh, factor));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), value);
+
+            const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(incoming + i));
+            const __m128i out = _mm_loadu_si128(reinterpret_cast<const __m128i*>(outgoing + i));
+            sumLow = _mm_sub_epi16(_mm_add_epi16(sumLow, _mm_unpacklo_epi8(in, zero)), _mm_unpacklo_epi8(out, zero));
+            sumHigh = _mm_sub_epi16(_mm_add_epi16(sumHigh, _mm_unpackhi_epi8(in, zero)), _mm_unpackhi_epi8(out, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(sum + i), sumLow);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(sum + i + 8), sumHigh);
+        }
+#endif
+        for (; i < bytes; ++i) {
+            row[i] = uchar((quint32(sum[i]) * multiplier) >> 16);
+            sum[i] = quint16(sum[i] + incoming[i] - outgoing[i]);
+        }
+    }
+}
+
+template <typename Segment>
+void QWinUIImageBlur::parallelFor(int count, qint64 workPerItem, Segment segment)
+{
+    QThreadPool* pool = QThreadPool::globalInstance();
+    const qint64 maxChunks = qMin<qint64>(qMax(1, pool->maxThreadCount()), count);
+    const int chunks = int(qBound<qint64>(1, qint64(count) * workPerItem / MIN_PARALLEL_WORK, maxChunks));
+    if (chunks <= 1) {
+        segment(0, count);
+        return;
+    }
+
+    QSemaphore finished;
+    int started = 0;
+    for (int i = 1; i < chunks; ++i) {
+        const int first = int(qint64(count) * i / chunks);
+        const int last = int(qint64(count) * (i + 1) / chunks);
+        // 线程池已满（例如本身就在池中调用）时在当前线程处理，避免互相等待
+        if (pool->tryStart([&segment, &finished, first, last]() {
+                segment(first, last);
+                finished.release();
+            })) {
+            ++started;
+        } else {
+            segment(first, last);
+        }
+    }
+
+    segment(0, count / chunks);
+    finished.acquire(started);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,38 @@
+#ifndef QWINUIIMAGEBLUR_H
+#define QWINUIIMAGEBLUR_H
+
+#include <QImage>
+
+QT_BEGIN_NAMESPACE
+
+// 软件模糊（内部类）
+// 近似高斯模糊：按半径先缩小图像，在小图上做三次可分离的盒式模糊，再放大回原尺寸。
+// 盒式模糊使用滑动窗口求和，每像素开销与半径无关；内层循环使用SSE2，
+// 大图按行（水平）和列条带（垂直）分给全局线程池并行处理。边缘按最近像素延伸。
+class QWinUIImageBlur
+{
+public:
+    // radius 为逻辑像素，模糊在约 radius 的距离内衰减完毕（sigma = radius / 3）；
+    // 返回 Format_ARGB32_Premultiplied 图像，保留设备像素比
+    static QImage blur(const QImage& image, qreal radius);
+
+    // 缩小倍数：分块处理时让各块的采样位置按该倍数对齐，拼接处才不会出现接缝
+    static int downsampleFactor(qreal radius, qreal devicePixelRatio);
+
+private:
+    static QImage downsample(const QImage& image, int factor);
+    static void boxBlurHorizontal(QImage& image, int radius);
+    static void boxBlurVertical(QImage& image, int radius);
+    static void boxBlurRows(uchar* bits, qsizetype stride, int width, int firstRow, int lastRow, int radius);
+    static void boxBlurColumns(uchar* bits, qsizetype stride, int height, int firstColumn, int lastColumn, int radius);
+    // 把 [0, count) 分成若干段并行执行，segment(first, last) 处理 [first, last)
+    template <typename Segment>
+    static void parallelFor(int count, qint64 workPerItem, Segment segment);
+
+    static constexpr int MAX_BOX_RADIUS = 127;        // 16位累加器的上限：255 × 255 < 65536
+    static constexpr qint64 MIN_PARALLEL_WORK = 65536; // 小于该像素数时单线程处理
+};
+
+QT_END_NAMESPACE
+
+#endif // QWINUIIMAGEBLUR_H
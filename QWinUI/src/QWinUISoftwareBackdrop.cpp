@@ -0,0 +1,399 @@
+#include "QWinUISoftwareBackdrop.h"
+#include "QWinUIImageBlur.h"
+#include "QWinUI/QWinUITheme.h"
+#include <QApplication>
+#include <QEvent>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QRadialGradient>
+#include <QWidget>
+#include <QtMath>
+
+QT_BEGIN_NAMESPACE
+
+QWinUISoftwareBackdrop::QWinUISoftwareBackdrop(QWidget* window)
+    : QObject(window)
+    , m_window(window)
+    , m_material(Acrylic)
+    , m_darkOverride(-1)
+    , m_fullRefresh(true)
+    , m_capturing(false)
+    , m_watchingContent(false)
+    , m_micaDark(false)
+    , m_micaTint(0)
+    , m_themeSerial(0)
+{
+    m_refreshTimer.setSingleShot(true);
+    m_refreshTimer.setInterval(ACRYLIC_REFRESH_INTERVAL_MS);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &QWinUISoftwareBackdrop::refreshAcrylic);
+
+    m_window->installEventFilter(this);
+
+    if (QWinUITheme* theme = QWinUITheme::getInstance()) {
+        m_themeSerial = theme->themeChangeSerial();
+    }
+}
+
+QWinUISoftwareBackdrop::~QWinUISoftwareBackdrop()
+{
+    if (m_watchingContent && qApp) {
+        qApp->removeEventFilter(this);
+    }
+    if (m_window) {
+        m_window->removeEventFilter(this);
+        m_window->update();
+    }
+}
+
+QWinUISoftwareBackdrop* QWinUISoftwareBackdrop::attach(QWidget* widget, Material material, const QColor& tintColor)
+{
+    QWidget* window = widget ? widget->window() : nullptr;
+    if (!window) {
+        return nullptr;
+    }
+
+    QWinUISoftwareBackdrop* backdrop = find(window);
+    if (!backdrop) {
+        backdrop = new QWinUISoftwareBackdrop(window);
+    }
+    backdrop->setMaterial(material, tintColor);
+    return backdrop;
+}
+
+bool QWinUISoftwareBackdrop::detach(QWidget* widget)
+{
+    QWinUISoftwareBackdrop* backdrop = find(widget);
+    if (!backdrop) {
+        return false;
+    }
+    delete backdrop;
+    return true;
+}
+
+QWinUISoftwareBackdrop* QWinUISoftwareBackdrop::find(const QWidget* widget)
+{
+    const QWidget* window = widget ? widget->window() : nullptr;
+    if (!window) {
+        return nullptr;
+    }
+    return window->findChild<QWinUISoftwareBackdrop*>(QString(), Qt::FindDirectChildrenOnly);
+}
+
+void QWinUISoftwareBackdrop::setMaterial(Material material, const QColor& tintColor)
+{
+    m_material = material;
+    m_tintColor = tintColor;
+
+    // Acrylic 需要得知窗口中任意控件的重绘，改为在应用程序上过滤事件（同时覆盖窗口自身）；
+    // 两处同时安装会让窗口的绘制事件经过过滤器两次
+    const bool watchContent = material == Acrylic;
+    if (watchContent != m_watchingContent) {
+        m_watchingContent = watchContent;
+        if (watchContent) {
+            m_window->removeEventFilter(this);
+            qApp->installEventFilter(this);
+        } else {
+            qApp->removeEventFilter(this);
+            m_window->installEventFilter(this);
+            m_acrylic = QImage();
+            m_content = QImage();
+            m_dirtyContent = QRegion();
+        }
+    }
+
+    invalidate();
+}
+
+void QWinUISoftwareBackdrop::setDarkMode(bool isDark)
+{
+    const int value = isDark ? 1 : 0;
+    if (m_darkOverride != value) {
+        m_darkOverride = value;
+        invalidate();
+    }
+}
+
+bool QWinUISoftwareBackdrop::isDark() const
+{
+    if (m_darkOverride >= 0) {
+        return m_darkOverride == 1;
+    }
+    QWinUITheme* theme = QWinUITheme::getInstance();
+    return theme && theme->isDarkMode();
+}
+
+QColor QWinUISoftwareBackdrop::baseColor() const
+{
+    return isDark() ? QColor(32, 32, 32) : QColor(243, 243, 243);
+}
+
+void QWinUISoftwareBackdrop::invalidate()
+{
+    // Mica 在下次绘制时按新参数重新生成
+    m_micaSize = QSize();
+    if (m_material == Acrylic) {
+        m_fullRefresh = true;
+        scheduleRefresh();
+    }
+    if (m_window) {
+        m_window->update();
+    }
+}
+
+bool QWinUISoftwareBackdrop::checkThemeSerial()
+{
+    QWinUITheme* theme = QWinUITheme::getInstance();
+    if (!theme || theme->themeChangeSerial() == m_themeSerial) {
+        return false;
+    }
+    m_themeSerial = theme->themeChangeSerial();
+    return true;
+}
+
+void QWinUISoftwareBackdrop::scheduleRefresh()
+{
+    if (m_refreshTimer.isActive()) {
+        return;
+    }
+    // 还没有结果时立即生成，之后按间隔合并连续的变化
+    m_refreshTimer.start(m_acrylic.isNull() ? 0 : ACRYLIC_REFRESH_INTERVAL_MS);
+}
+
+void QWinUISoftwareBackdrop::refreshAcrylic()
+{
+    if (!m_window || m_material != Acrylic || !m_window->isVisible() || m_window->size().isEmpty()) {
+        return;
+    }
+
+    // 背景层自身的重绘会带动窗口内容重绘，这部分不是内容变化；
+    // 同一间隔内恰好落在其中的真实变化要等下一次重绘时才会反映
+    const QRegion dirty = (m_dirtyContent - m_ownRepaint) & m_window->rect();
+    m_dirtyContent = QRegion();
+    m_ownRepaint = QRegion();
+
+    // 直接按缩小后的尺寸绘制窗口内容，绘制、模糊的开销都只有原尺寸的 1 / ACRYLIC_SCALE²
+    const QSize size((m_window->width() + ACRYLIC_SCALE - 1) / ACRYLIC_SCALE,
+                     (m_window->height() + ACRYLIC_SCALE - 1) / ACRYLIC_SCALE);
+    if (m_fullRefresh || m_content.size() != size) {
+        m_fullRefresh = false;
+        m_content = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        renderContent(m_content.rect());
+
+        const QImage result = tint(QWinUIImageBlur::blur(m_content, ACRYLIC_BLUR_RADIUS / ACRYLIC_SCALE), 0.5);
+        if (result != m_acrylic) {
+            m_acrylic = result;
+            repaintAcrylic(m_window->rect());
+        }
+        return;
+    }
+
+    // 只重新处理变化的区域，闪烁的光标、旋转的进度环只影响周围一小块
+    QList<QRect> rects;
+    if (dirty.rectCount() > MAX_DIRTY_RECTS) {
+        rects.append(dirty.boundingRect());
+    } else {
+        rects = QList<QRect>(dirty.begin(), dirty.end());
+    }
+
+    QRegion repaint;
+    for (const QRect& rect : std::as_const(rects)) {
+        // 按缩小倍数向外对齐，各块的采样网格与整图一致
+        const QRect scaledRect = QRect(QPoint(rect.left() / ACRYLIC_SCALE, rect.top() / ACRYLIC_SCALE),
+                                       QPoint(rect.right() / ACRYLIC_SCALE, rect.bottom() / ACRYLIC_SCALE))
+                                 & m_content.rect();
+        if (scaledRect.isEmpty()) {
+            continue;
+        }
+        renderContent(scaledRect);
+        repaint += updateAcrylic(scaledRect);
+    }
+    if (!repaint.isEmpty()) {
+        repaintAcrylic(repaint);
+    }
+}
+
+void QWinUISoftwareBackdrop::renderContent(const QRect& scaledRect)
+{
+    QImage patch(scaledRect.size(), QImage::Format_ARGB32_Premultiplied);
+    patch.fill(baseColor());
+    {
+        const QRect source(scaledRect.topLeft() * ACRYLIC_SCALE, scaledRect.size() * ACRYLIC_SCALE);
+        const QRegion region = QRegion(source) & m_window->rect();
+
+        QPainter painter(&patch);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        painter.scale(1.0 / ACRYLIC_SCALE, 1.0 / ACRYLIC_SCALE);
+
+        // 离屏绘制期间不绘制背景层，也不把产生的绘制事件当作内容变化；
+        // render() 把区域的左上角绘制在 targetOffset 处
+        m_capturing = true;
+        m_window->render(&painter, region.boundingRect().topLeft() - source.topLeft(), region,
+                         QWidget::DrawChildren);
+        m_capturing = false;
+    }
+
+    QPainter painter(&m_content);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.drawImage(scaledRect.topLeft(), patch);
+}
+
+QRect QWinUISoftwareBackdrop::updateAcrylic(const QRect& scaledRect)
+{
+    // 模糊结果受半径范围内的内容影响：受影响区域向外扩展一个半径，
+    // 计算时再向外取一个半径的内容作为输入
+    const qreal radius = ACRYLIC_BLUR_RADIUS / ACRYLIC_SCALE;
+    const int margin = qCeil(radius);
+    const QRect bounds = m_content.rect();
+    const QRect target = scaledRect.adjusted(-margin, -margin, margin, margin) & bounds;
+    const int factor = QWinUIImageBlur::downsampleFactor(radius, 1.0);
+    QRect source = target.adjusted(-margin, -margin, margin, margin);
+    source.setLeft(qFloor(source.left() / qreal(factor)) * factor);
+    source.setTop(qFloor(source.top() / qreal(factor)) * factor);
+    source &= bounds;
+    if (target.isEmpty()) {
+        return QRect();
+    }
+
+    const QImage blurred = tint(QWinUIImageBlur::blur(m_content.copy(source), radius), 0.5);
+    const QImage patch = blurred.copy(target.translated(-source.topLeft()));
+    if (patch == m_acrylic.copy(target)) {
+        return QRect();
+    }
+
+    QPainter painter(&m_acrylic);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.drawImage(target.topLeft(), patch);
+    return QRect(target.topLeft() * ACRYLIC_SCALE, target.size() * ACRYLIC_SCALE);
+}
+
+void QWinUISoftwareBackdrop::repaintAcrylic(const QRegion& region)
+{
+    m_ownRepaint += region;
+    m_window->update(region);
+}
+
+void QWinUISoftwareBackdrop::ensureMica()
+{
+    const qreal dpr = m_window->devicePixelRatioF();
+    const QSize deviceSize = (QSizeF(m_window->size()) * dpr).toSize();
+    const bool dark = isDark();
+    const QRgb tintColor = m_tintColor.isValid() ? m_tintColor.rgba() : 0;
+    if (!m_mica.isNull() && m_micaSize == deviceSize && m_micaDark == dark && m_micaTint == tintColor) {
+        return;
+    }
+
+    // 低分辨率底图：基础色上叠加两团柔和的强调色，模拟壁纸经重度模糊后的色块
+    const QSize size(qMax(1, m_window->width() / MICA_SCALE), qMax(1, m_window->height() / MICA_SCALE));
+    QImage base(size, QImage::Format_ARGB32_Premultiplied);
+    base.fill(baseColor());
+    {
+        QWinUITheme* theme = QWinUITheme::getInstance();
+        QColor accent = theme ? theme->accentColor() : QColor(0, 120, 215);
+        if (m_tintColor.isValid() && m_tintColor.alpha() > 0) {
+            accent = m_tintColor;
+        }
+
+        QPainter painter(&base);
+        const qreal extent = qMax(size.width(), size.height());
+        const QPointF centers[2] = {
+            QPointF(size.width() * 0.15, size.height() * 0.1),
+            QPointF(size.width() * 0.85, size.height() * 0.9)
+        };
+        for (int i = 0; i < 2; ++i) {
+            QColor inner = i == 0 ? accent : accent.lighter(dark ? 80 : 130);
+            inner.setAlphaF(dark ? 0.25 : 0.2);
+            QColor outer = inner;
+            outer.setAlpha(0);
+
+            QRadialGradient gradient(centers[i], extent * 0.7);
+            gradient.setColorAt(0.0, inner);
+            gradient.setColorAt(1.0, outer);
+            painter.fillRect(base.rect(), gradient);
+        }
+    }
+
+    // 着色层较重，底图只透出微弱的颜色变化；MicaAlt 着色更轻，颜色更明显
+    const qreal baseOpacity = m_material == MicaAlt ? 0.5 : 0.8;
+    const QImage tinted = tint(QWinUIImageBlur::blur(base, MICA_BLUR_RADIUS / MICA_SCALE), baseOpacity);
+
+    m_mica = QPixmap::fromImage(tinted.scaled(deviceSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    m_mica.setDevicePixelRatio(dpr);
+    m_micaSize = deviceSize;
+    m_micaDark = dark;
+    m_micaTint = tintColor;
+}
+
+QImage QWinUISoftwareBackdrop::tint(QImage image, qreal baseOpacity) const
+{
+    QPainter painter(&image);
+
+    QColor base = baseColor();
+    base.setAlphaF(baseOpacity);
+    painter.fillRect(image.rect(), base);
+
+    if (m_material == Acrylic && m_tintColor.isValid() && m_tintColor.alpha() > 0) {
+        painter.fillRect(image.rect(), m_tintColor);
+    }
+    return image;
+}
+
+void QWinUISoftwareBackdrop::paintBackdrop(QPaintEvent* event)
+{
+    QPainter painter(m_window);
+    painter.setClipRegion(event->region());
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+
+    if (m_material == Acrylic) {
+        // 尺寸变化后、新结果生成前，旧结果覆盖不到的部分显示基础色
+        painter.fillRect(m_window->rect(), baseColor());
+        if (m_acrylic.isNull()) {
+            return;
+        }
+        // 按整数倍拉伸，与缩小时的像素网格对齐
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        painter.drawImage(QRectF(0, 0, m_acrylic.width() * ACRYLIC_SCALE, m_acrylic.height() * ACRYLIC_SCALE),
+                          m_acrylic);
+        return;
+    }
+
+    ensureMica();
+    painter.drawPixmap(0, 0, m_mica);
+}
+
+bool QWinUISoftwareBackdrop::eventFilter(QObject* watched, QEvent* event)
+{
+    if (!m_window) {
+        return false;
+    }
+
+    switch (event->type()) {
+    case QEvent::Paint:
+        if (m_capturing || !watched->isWidgetType()) {
+            break;
+        }
+        // 主题变化时窗口中的控件会重绘，在这里得知主题已变化，不单独监听主题信号
+        if (checkThemeSerial()) {
+            invalidate();
+        }
+        if (watched == m_window) {
+            // 先于窗口自身的 paintEvent 执行，窗口内容绘制在背景层之上
+            paintBackdrop(static_cast<QPaintEvent*>(event));
+        } else if (m_material == Acrylic && static_cast<QWidget*>(watched)->window() == m_window) {
+            QWidget* widget = static_cast<QWidget*>(watched);
+            m_dirtyContent += static_cast<QPaintEvent*>(event)->region().translated(widget->mapTo(m_window, QPoint()));
+            scheduleRefresh();
+        }
+        break;
+    case QEvent::Resize:
+    case QEvent::Show:
+        if (watched == m_window) {
+            invalidate();
+        }
+        break;
+    default:
+        break;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,95 @@
+#ifndef QWINUISOFTWAREBACKDROP_H
+#define QWINUISOFTWAREBACKDROP_H
+
+#include <QObject>
+#include <QColor>
+#include <QImage>
+#include <QPixmap>
+#include <QPointer>
+#include <QTimer>
+
+QT_BEGIN_NAMESPACE
+
+class QPaintEvent;
+class QWidget;
+
+// 窗口背景材质的软件实现（内部类）
+// 在没有系统合成器支持的平台上代替 QWinUIBlurEffect：在窗口自身内容之下先绘制一层背景。
+// Mica：主题色生成的低分辨率底图，重度模糊并着色后放大，每个窗口尺寸和主题只生成一次；
+// Acrylic：把窗口自身的内容按缩小比例离屏绘制后模糊并着色，内容变化时按固定间隔节流刷新，
+// 只重新绘制、模糊和重绘变化区域影响到的部分
+class QWinUISoftwareBackdrop : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Material {
+        Acrylic,
+        Mica,
+        MicaAlt
+    };
+
+    // 为窗口启用（或更新）软件背景；widget 可以是窗口中的任意控件
+    static QWinUISoftwareBackdrop* attach(QWidget* widget, Material material, const QColor& tintColor);
+    static bool detach(QWidget* widget);
+    static QWinUISoftwareBackdrop* find(const QWidget* widget);
+
+    void setMaterial(Material material, const QColor& tintColor);
+    // 深浅色；未设置时跟随全局主题
+    void setDarkMode(bool isDark);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    explicit QWinUISoftwareBackdrop(QWidget* window);
+    ~QWinUISoftwareBackdrop();
+
+    bool isDark() const;
+    QColor baseColor() const;
+    void invalidate();
+    bool checkThemeSerial(); // 主题在上次检查之后是否变化过
+    void scheduleRefresh();
+    void refreshAcrylic();
+    void renderContent(const QRect& scaledRect);  // 重新绘制缩小后内容中的一块（缩小后的坐标）
+    QRect updateAcrylic(const QRect& scaledRect); // 重新模糊受影响的部分，返回需要重绘的窗口区域
+    void repaintAcrylic(const QRegion& region);
+    void ensureMica();
+    QImage tint(QImage image, qreal baseOpacity) const; // 叠加基础色和着色层
+    void paintBackdrop(QPaintEvent* event);
+
+private:
+    QPointer<QWidget> m_window;
+    Material m_material;
+    QColor m_tintColor;
+    int m_darkOverride; // -1 跟随主题，0 浅色，1 深色
+
+    // Acrylic：缩小后的窗口内容，模糊并着色后绘制时拉伸到窗口大小
+    QImage m_content;       // 未模糊的缩小内容
+    QImage m_acrylic;
+    QRegion m_dirtyContent; // 内容有变化的区域（窗口坐标）
+    QRegion m_ownRepaint;   // 背景层自身请求的重绘，由此引起的内容重绘不是变化
+    bool m_fullRefresh;     // 材质、主题或尺寸变化后整体重新生成
+    QTimer m_refreshTimer;
+    bool m_capturing;
+    bool m_watchingContent;
+
+    // Mica：按窗口设备像素生成的完整底图
+    QPixmap m_mica;
+    QSize m_micaSize;
+    bool m_micaDark;
+    QRgb m_micaTint;
+
+    quint64 m_themeSerial; // 最近一次生成时的主题变化序号
+
+    static constexpr int ACRYLIC_SCALE = 4;                 // 窗口内容缩小倍数
+    static constexpr int ACRYLIC_REFRESH_INTERVAL_MS = 100; // 内容变化后最快的刷新间隔
+    static constexpr qreal ACRYLIC_BLUR_RADIUS = 30.0;      // 逻辑像素
+    static constexpr int MAX_DIRTY_RECTS = 8;               // 脏区域矩形过多时按外接矩形处理
+    static constexpr int MICA_SCALE = 16;                   // Mica 底图缩小倍数
+    static constexpr qreal MICA_BLUR_RADIUS = 120.0;        // 逻辑像素
+};
+
+QT_END_NAMESPACE
+
+#endif // QWINUISOFTWAREBACKDROP_H
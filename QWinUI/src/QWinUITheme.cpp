@@ -4,8 +4,13 @@
 #include <QStyleHints>
 #include <QStandardPaths>
 #include <QDir>
+#include <QFileInfo>
 #include <QDebug>
 #include <QPalette>
+#include <QHash>
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
 
 #ifdef Q_OS_WIN
 #include <Windows.h>
@@ -38,15 +43,99 @@ const QString QWinUITheme::Colors::ControlFillColorInputActive = "ControlFillCol
 
 const QString QWinUITheme::Colors::ControlStrokeColorDefault = "ControlStrokeColorDefault";
 const QString QWinUITheme::Colors::ControlStrokeColorSecondary = "ControlStrokeColorSecondary";
+const QString QWinUITheme::Colors::ControlStrokeColorOnAccentDefault = "ControlStrokeColorOnAccentDefault";
+const QString QWinUITheme::Colors::ControlStrokeColorOnAccentSecondary = "ControlStrokeColorOnAccentSecondary";
+const QString QWinUITheme::Colors::ControlStrokeColorOnAccentTertiary = "ControlStrokeColorOnAccentTertiary";
+const QString QWinUITheme::Colors::ControlStrokeColorOnAccentDisabled = "ControlStrokeColorOnAccentDisabled";
+const QString QWinUITheme::Colors::ControlStrokeColorForStrongFillWhenOnImage = "ControlStrokeColorForStrongFillWhenOnImage";
 const QString QWinUITheme::Colors::ControlStrokeColorDisabled = "ControlStrokeColorDisabled";
 
 const QString QWinUITheme::Colors::TextFillColorPrimary = "TextFillColorPrimary";
 const QString QWinUITheme::Colors::TextFillColorSecondary = "TextFillColorSecondary";
 const QString QWinUITheme::Colors::TextFillColorTertiary = "TextFillColorTertiary";
 const QString QWinUITheme::Colors::TextFillColorDisabled = "TextFillColorDisabled";
+const QString QWinUITheme::Colors::TextFillColorInverse = "TextFillColorInverse";
 
 const QString QWinUITheme::Colors::ApplicationPageBackgroundThemeBrush = "ApplicationPageBackgroundThemeBrush";
 const QString QWinUITheme::Colors::LayerFillColorDefault = "LayerFillColorDefault";
+const QString QWinUITheme::Colors::LayerFillColorAlt = "LayerFillColorAlt";
+const QString QWinUITheme::Colors::LayerOnAcrylicFillColorDefault = "LayerOnAcrylicFillColorDefault";
+const QString QWinUITheme::Colors::LayerOnAccentAcrylicFillColorDefault = "LayerOnAccentAcrylicFillColorDefault";
+
+const QString QWinUITheme::Colors::NeutralPrimary = "NeutralPrimary";
+const QString QWinUITheme::Colors::NeutralSecondary = "NeutralSecondary";
+const QString QWinUITheme::Colors::NeutralTertiary = "NeutralTertiary";
+const QString QWinUITheme::Colors::NeutralQuaternary = "NeutralQuaternary";
+const QString QWinUITheme::Colors::NeutralLight = "NeutralLight";
+const QString QWinUITheme::Colors::NeutralLighter = "NeutralLighter";
+const QString QWinUITheme::Colors::NeutralLightest = "NeutralLightest";
+
+const QString QWinUITheme::Colors::SystemFillColorSuccess = "SystemFillColorSuccess";
+const QString QWinUITheme::Colors::SystemFillColorCaution = "SystemFillColorCaution";
+const QString QWinUITheme::Colors::SystemFillColorCritical = "SystemFillColorCritical";
+const QString QWinUITheme::Colors::SystemFillColorNeutral = "SystemFillColorNeutral";
+const QString QWinUITheme::Colors::SystemFillColorSolidNeutral = "SystemFillColorSolidNeutral";
+const QString QWinUITheme::Colors::SystemFillColorAttentionBackground = "SystemFillColorAttentionBackground";
+const QString QWinUITheme::Colors::SystemFillColorSuccessBackground = "SystemFillColorSuccessBackground";
+const QString QWinUITheme::Colors::SystemFillColorCautionBackground = "SystemFillColorCautionBackground";
+const QString QWinUITheme::Colors::SystemFillColorCriticalBackground = "SystemFillColorCriticalBackground";
+
+// 颜色令牌名称表，顺序必须与 ColorToken 枚举一致
+static const char* const s_colorTokenNames[] = {
+    "SystemAccentColor",
+    "SystemAccentColorLight1",
+    "SystemAccentColorLight2",
+    "SystemAccentColorLight3",
+    "SystemAccentColorDark1",
+    "SystemAccentColorDark2",
+    "SystemAccentColorDark3",
+    "ControlFillColorDefault",
+    "ControlFillColorSecondary",
+    "ControlFillColorTertiary",
+    "ControlFillColorDisabled",
+    "ControlFillColorTransparent",
+    "ControlFillColorInputActive",
+    "ControlStrokeColorDefault",
+    "ControlStrokeColorSecondary",
+    "ControlStrokeColorOnAccentDefault",
+    "ControlStrokeColorOnAccentSecondary",
+    "ControlStrokeColorOnAccentTertiary",
+    "ControlStrokeColorOnAccentDisabled",
+    "ControlStrokeColorForStrongFillWhenOnImage",
+    "ControlStrokeColorDisabled",
+    "TextFillColorPrimary",
+    "TextFillColorSecondary",
+    "TextFillColorTertiary",
+    "TextFillColorDisabled",
+    "TextFillColorInverse",
+    "ApplicationPageBackgroundThemeBrush",
+    "LayerFillColorDefault",
+    "LayerFillColorAlt",
+    "LayerOnAcrylicFillColorDefault",
+    "LayerOnAccentAcrylicFillColorDefault",
+    "NeutralPrimary",
+    "NeutralSecondary",
+    "NeutralTertiary",
+    "NeutralQuaternary",
+    "NeutralLight",
+    "NeutralLighter",
+    "NeutralLightest",
+    "SystemFillColorSuccess",
+    "SystemFillColorCaution",
+    "SystemFillColorCritical",
+    "SystemFillColorNeutral",
+    "SystemFillColorSolidNeutral",
+    "SystemFillColorAttentionBackground",
+    "SystemFillColorSuccessBackground",
+    "SystemFillColorCautionBackground",
+    "SystemFillColorCriticalBackground",
+};
+static_assert(sizeof(s_colorTokenNames) / sizeof(s_colorTokenNames[0]) == QWinUITheme::ColorTokenCount,
+              "s_colorTokenNames must match QWinUITheme::ColorToken");
+
+// 主题文件格式
+static const quint32 THEME_FILE_MAGIC = 0x51575448; // "QWTH"
+static const quint16 THEME_FILE_VERSION = 1;
 
 // 字体名称常量定义
 const QString QWinUITheme::Fonts::CaptionTextBlockStyle = "CaptionTextBlockStyle";
@@ -86,9 +175,14 @@ QWinUITheme::QWinUITheme(QObject* parent)
     : QObject(parent)
     , m_themeMode(QWinUIThemeMode::Auto)
     , m_accentColor(QColor(0, 120, 215)) // Windows 11默认蓝色
+    , m_accentOverridden(false)
     , m_followSystemTheme(true)
     , m_isDarkMode(false)
-    , m_settings(nullptr)
+    , m_isHighContrast(false)
+    , m_paletteGeneration(0)
+    , m_updateDepth(0)
+    , m_hasStagedColors(false)
+    , m_themeChangeSerial(0)
     , m_themeTransitionEnabled(true)
     , m_themeTransitionMode(0) // 0 = RippleTransition
 {
@@ -97,19 +191,17 @@ QWinUITheme::QWinUITheme(QObject* parent)
 
 QWinUITheme::~QWinUITheme()
 {
-    disconnectFromSystemTheme();
-    if (m_settings) {
-        delete m_settings;
+    // 控件可能比主题对象存活更久，通知它们不再需要注销
+    for (QWinUIWidget* widget : std::as_const(m_visibleWidgets)) {
+        widget->m_themeRegistered = false;
     }
+    m_visibleWidgets.clear();
+
+    disconnectFromSystemTheme();
 }
 
 void QWinUITheme::initializeTheme()
 {
-    // 创建设置对象
-    QString configPath = QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation);
-    QDir().mkpath(configPath);
-    m_settings = new QSettings(configPath + "/qwinui_theme.ini", QSettings::IniFormat);
-
     // 初始化字体
     QFont defaultFont("Segoe UI Variable", 14);
     m_fonts[Fonts::BodyTextBlockStyle] = defaultFont;
@@ -153,6 +245,9 @@ void QWinUITheme::initializeTheme()
     // 获取系统强调色
     m_accentColor = getSystemAccentColor();
 
+    // 检测系统高对比度设置
+    m_isHighContrast = getSystemHighContrast();
+
     // 检测系统主题
     if (m_followSystemTheme) {
         connectToSystemTheme();
@@ -162,11 +257,9 @@ void QWinUITheme::initializeTheme()
         switch (m_themeMode) {
         case QWinUIThemeMode::Light:
             m_isDarkMode = false;
-            loadLightTheme();
             break;
         case QWinUIThemeMode::Dark:
             m_isDarkMode = true;
-            loadDarkTheme();
             break;
         case QWinUIThemeMode::Auto:
             onSystemThemeChanged();
@@ -174,53 +267,274 @@ void QWinUITheme::initializeTheme()
         }
     }
 
-    updateAccentColorVariants();
+    // 构建初始调色板（系统检测为浅色时上面不会触发重建）
+    if (!m_palette) {
+        rebuildPalette();
+    }
 }
 
-void QWinUITheme::loadLightTheme()
+const QWinUITheme::ColorTable& QWinUITheme::loadLightTheme()
 {
-    // WinUI 3 浅色主题颜色
-    m_colors[Colors::ControlFillColorDefault] = QColor(255, 255, 255, 179);  // rgba(255,255,255,0.7)
-    m_colors[Colors::ControlFillColorSecondary] = QColor(249, 249, 249, 128); // rgba(249,249,249,0.5)
-    m_colors[Colors::ControlFillColorTertiary] = QColor(249, 249, 249, 77);   // rgba(249,249,249,0.3)
-    m_colors[Colors::ControlFillColorDisabled] = QColor(249, 249, 249, 77);   // rgba(249,249,249,0.3)
-    m_colors[Colors::ControlFillColorTransparent] = QColor(255, 255, 255, 0);
-    m_colors[Colors::ControlFillColorInputActive] = QColor(255, 255, 255);
+    // WinUI 3 浅色主题颜色，只构建一次
+    static const ColorTable colors = []() {
+        ColorTable table;
+        auto set = [&table](ColorToken token, const QColor& color) {
+            table[static_cast<int>(token)] = color;
+        };
+
+        set(ColorToken::ControlFillColorDefault, QColor(255, 255, 255, 179)); // rgba(255,255,255,0.7)
+        set(ColorToken::ControlFillColorSecondary, QColor(249, 249, 249, 128)); // rgba(249,249,249,0.5)
+        set(ColorToken::ControlFillColorTertiary, QColor(249, 249, 249, 77)); // rgba(249,249,249,0.3)
+        set(ColorToken::ControlFillColorDisabled, QColor(249, 249, 249, 77)); // rgba(249,249,249,0.3)
+        set(ColorToken::ControlFillColorTransparent, QColor(255, 255, 255, 0));
+        set(ColorToken::ControlFillColorInputActive, QColor(255, 255, 255));
+
+        set(ColorToken::ControlStrokeColorDefault, QColor(117, 117, 117, 102)); // rgba(117,117,117,0.4)
+        set(ColorToken::ControlStrokeColorSecondary, QColor(117, 117, 117, 64)); // rgba(117,117,117,0.25)
+        set(ColorToken::ControlStrokeColorDisabled, QColor(117, 117, 117, 51)); // rgba(117,117,117,0.2)
+
+        set(ColorToken::TextFillColorPrimary, QColor(14, 14, 14, 230)); // rgba(14,14,14,0.9)
+        set(ColorToken::TextFillColorSecondary, QColor(96, 96, 96, 160)); // rgba(96,96,96,0.63)
+        set(ColorToken::TextFillColorTertiary, QColor(96, 96, 96, 115)); // rgba(96,96,96,0.45)
+        set(ColorToken::TextFillColorDisabled, QColor(96, 96, 96, 92)); // rgba(96,96,96,0.36)
+
+        set(ColorToken::ApplicationPageBackgroundThemeBrush, QColor(243, 243, 243));
+        set(ColorToken::LayerFillColorDefault, QColor(255, 255, 255, 128)); // rgba(255,255,255,0.5)
+
+        return table;
+    }();
+    return colors;
+}
 
-    m_colors[Colors::ControlStrokeColorDefault] = QColor(117, 117, 117, 102); // rgba(117,117,117,0.4)
-    m_colors[Colors::ControlStrokeColorSecondary] = QColor(117, 117, 117, 64); // rgba(117,117,117,0.25)
-    m_colors[Colors::ControlStrokeColorDisabled] = QColor(117, 117, 117, 51);  // rgba(117,117,117,0.2)
+const QWinUITheme::ColorTable& QWinUITheme::loadDarkTheme()
+{
+    // WinUI 3 深色主题颜色，只构建一次
+    static const ColorTable colors = []() {
+        ColorTable table;
+        auto set = [&table](ColorToken token, const QColor& color) {
+            table[static_cast<int>(token)] = color;
+        };
+
+        set(ColorToken::ControlFillColorDefault, QColor(255, 255, 255, 15)); // rgba(255,255,255,0.06)
+        set(ColorToken::ControlFillColorSecondary, QColor(255, 255, 255, 23)); // rgba(255,255,255,0.09)
+        set(ColorToken::ControlFillColorTertiary, QColor(255, 255, 255, 13)); // rgba(255,255,255,0.05)
+        set(ColorToken::ControlFillColorDisabled, QColor(255, 255, 255, 10)); // rgba(255,255,255,0.04)
+        set(ColorToken::ControlFillColorTransparent, QColor(255, 255, 255, 0));
+        set(ColorToken::ControlFillColorInputActive, QColor(30, 30, 30));
+
+        set(ColorToken::ControlStrokeColorDefault, QColor(255, 255, 255, 18)); // rgba(255,255,255,0.07)
+        set(ColorToken::ControlStrokeColorSecondary, QColor(255, 255, 255, 26)); // rgba(255,255,255,0.1)
+        set(ColorToken::ControlStrokeColorDisabled, QColor(255, 255, 255, 13)); // rgba(255,255,255,0.05)
+
+        set(ColorToken::TextFillColorPrimary, QColor(255, 255, 255));
+        set(ColorToken::TextFillColorSecondary, QColor(255, 255, 255, 194)); // rgba(255,255,255,0.76)
+        set(ColorToken::TextFillColorTertiary, QColor(255, 255, 255, 140)); // rgba(255,255,255,0.55)
+        set(ColorToken::TextFillColorDisabled, QColor(255, 255, 255, 92)); // rgba(255,255,255,0.36)
+
+        set(ColorToken::ApplicationPageBackgroundThemeBrush, QColor(32, 32, 32));
+        set(ColorToken::LayerFillColorDefault, QColor(58, 58, 58, 77)); // rgba(58,58,58,0.3)
+
+        return table;
+    }();
+    return colors;
+}
 
-    m_colors[Colors::TextFillColorPrimary] = QColor(14, 14, 14, 230);    // rgba(14,14,14,0.9)
-    m_colors[Colors::TextFillColorSecondary] = QColor(96, 96, 96, 160);  // rgba(96,96,96,0.63)
-    m_colors[Colors::TextFillColorTertiary] = QColor(96, 96, 96, 115);   // rgba(96,96,96,0.45)
-    m_colors[Colors::TextFillColorDisabled] = QColor(96, 96, 96, 92);    // rgba(96,96,96,0.36)
+const QWinUITheme::ColorTable& QWinUITheme::loadHighContrastTheme()
+{
+    // 高对比度主题颜色（参照 Windows 高对比度黑色方案），只构建一次
+    static const ColorTable colors = []() {
+        ColorTable table;
+        auto set = [&table](ColorToken token, const QColor& color) {
+            table[static_cast<int>(token)] = color;
+        };
+
+        const QColor window(0, 0, 0);
+        const QColor windowText(255, 255, 255);
+        const QColor highlight(26, 235, 255);
+        const QColor highlightText(0, 0, 0);
+        const QColor grayText(63, 242, 63);
+
+        // 强调色固定为系统高亮色，不随用户强调色变化
+        set(ColorToken::SystemAccentColor, highlight);
+        set(ColorToken::SystemAccentColorLight1, highlight);
+        set(ColorToken::SystemAccentColorLight2, highlight);
+        set(ColorToken::SystemAccentColorLight3, highlight);
+        set(ColorToken::SystemAccentColorDark1, highlight);
+        set(ColorToken::SystemAccentColorDark2, highlight);
+        set(ColorToken::SystemAccentColorDark3, highlight);
+
+        set(ColorToken::ControlFillColorDefault, window);
+        set(ColorToken::ControlFillColorSecondary, window);
+        set(ColorToken::ControlFillColorTertiary, window);
+        set(ColorToken::ControlFillColorDisabled, window);
+        set(ColorToken::ControlFillColorTransparent, QColor(0, 0, 0, 0));
+        set(ColorToken::ControlFillColorInputActive, window);
+
+        set(ColorToken::ControlStrokeColorDefault, windowText);
+        set(ColorToken::ControlStrokeColorSecondary, windowText);
+        set(ColorToken::ControlStrokeColorOnAccentDefault, highlightText);
+        set(ColorToken::ControlStrokeColorOnAccentSecondary, highlightText);
+        set(ColorToken::ControlStrokeColorOnAccentTertiary, highlightText);
+        set(ColorToken::ControlStrokeColorOnAccentDisabled, grayText);
+        set(ColorToken::ControlStrokeColorForStrongFillWhenOnImage, windowText);
+        set(ColorToken::ControlStrokeColorDisabled, grayText);
+
+        set(ColorToken::TextFillColorPrimary, windowText);
+        set(ColorToken::TextFillColorSecondary, windowText);
+        set(ColorToken::TextFillColorTertiary, windowText);
+        set(ColorToken::TextFillColorDisabled, grayText);
+        set(ColorToken::TextFillColorInverse, highlightText);
+
+        set(ColorToken::ApplicationPageBackgroundThemeBrush, window);
+        set(ColorToken::LayerFillColorDefault, window);
+        set(ColorToken::LayerFillColorAlt, window);
+        set(ColorToken::LayerOnAcrylicFillColorDefault, window);
+        set(ColorToken::LayerOnAccentAcrylicFillColorDefault, window);
+
+        return table;
+    }();
+    return colors;
+}
 
-    m_colors[Colors::ApplicationPageBackgroundThemeBrush] = QColor(243, 243, 243);
-    m_colors[Colors::LayerFillColorDefault] = QColor(255, 255, 255, 128); // rgba(255,255,255,0.5)
+QWinUITheme::Palette::Palette(const ColorTable& colors, quint64 generation, bool isDark, bool isHighContrast)
+    : m_colors(colors)
+    , m_generation(generation)
+    , m_isDark(isDark)
+    , m_isHighContrast(isHighContrast)
+{
 }
 
-void QWinUITheme::loadDarkTheme()
+QWinUITheme::PalettePtr QWinUITheme::palette() const
 {
-    // WinUI 3 深色主题颜色
-    m_colors[Colors::ControlFillColorDefault] = QColor(255, 255, 255, 15);   // rgba(255,255,255,0.06)
-    m_colors[Colors::ControlFillColorSecondary] = QColor(255, 255, 255, 23);  // rgba(255,255,255,0.09)
-    m_colors[Colors::ControlFillColorTertiary] = QColor(255, 255, 255, 13);   // rgba(255,255,255,0.05)
-    m_colors[Colors::ControlFillColorDisabled] = QColor(255, 255, 255, 10);   // rgba(255,255,255,0.04)
-    m_colors[Colors::ControlFillColorTransparent] = QColor(255, 255, 255, 0);
-    m_colors[Colors::ControlFillColorInputActive] = QColor(30, 30, 30);
+    return std::atomic_load(&m_palette);
+}
+
+quint64 QWinUITheme::paletteGeneration() const
+{
+    return m_paletteGeneration.load(std::memory_order_acquire);
+}
 
-    m_colors[Colors::ControlStrokeColorDefault] = QColor(255, 255, 255, 18);  // rgba(255,255,255,0.07)
-    m_colors[Colors::ControlStrokeColorSecondary] = QColor(255, 255, 255, 26); // rgba(255,255,255,0.1)
-    m_colors[Colors::ControlStrokeColorDisabled] = QColor(255, 255, 255, 13);  // rgba(255,255,255,0.05)
+void QWinUITheme::rebuildPalette()
+{
+    // 从当前模式的基础颜色表出发，叠加强调色变体后整体替换，setColor 的修改随之丢弃。
+    // 批量修改期间暂存的 setColor 修改同样被替换，不再为它们发出 colorChanged
+    m_overriddenTokens.reset();
+    m_pendingColorSignals.reset();
+    const ColorTokenSet allTokens = ColorTokenSet().set();
+    if (m_isHighContrast) {
+        commitColors(loadHighContrastTheme(), allTokens);
+        return;
+    }
 
-    m_colors[Colors::TextFillColorPrimary] = QColor(255, 255, 255);
-    m_colors[Colors::TextFillColorSecondary] = QColor(255, 255, 255, 194);   // rgba(255,255,255,0.76)
-    m_colors[Colors::TextFillColorTertiary] = QColor(255, 255, 255, 140);    // rgba(255,255,255,0.55)
-    m_colors[Colors::TextFillColorDisabled] = QColor(255, 255, 255, 92);     // rgba(255,255,255,0.36)
+    ColorTable colors = m_isDarkMode ? loadDarkTheme() : loadLightTheme();
+    applyAccentColorVariants(colors);
+    commitColors(colors, allTokens);
+}
 
-    m_colors[Colors::ApplicationPageBackgroundThemeBrush] = QColor(32, 32, 32);
-    m_colors[Colors::LayerFillColorDefault] = QColor(58, 58, 58, 77); // rgba(58,58,58,0.3)
+const QWinUITheme::ColorTable& QWinUITheme::currentColors() const
+{
+    // 批量修改期间以暂存的颜色为准
+    return m_hasStagedColors ? m_stagedColors : m_palette->colors();
+}
+
+void QWinUITheme::commitColors(const ColorTable& colors, const ColorTokenSet& changedTokens)
+{
+    if (m_updateDepth > 0) {
+        m_stagedColors = colors;
+        m_hasStagedColors = true;
+        m_pendingTokens |= changedTokens;
+        return;
+    }
+
+    publishPalette(colors);
+    notifyThemeChanged(changedTokens);
+}
+
+void QWinUITheme::notifyThemeChanged(const ColorTokenSet& changedTokens)
+{
+    ++m_themeChangeSerial;
+
+    // 只刷新当前可见的控件；刷新过程中控件可能被隐藏，先取快照再逐个确认
+    const QList<QWinUIWidget*> widgets = m_visibleWidgets.values();
+    for (QWinUIWidget* widget : widgets) {
+        if (m_visibleWidgets.contains(widget)) {
+            widget->onThemeChangedInternal(changedTokens);
+        }
+    }
+
+    emit themeChanged(changedTokens);
+}
+
+void QWinUITheme::registerVisibleWidget(QWinUIWidget* widget)
+{
+    m_visibleWidgets.insert(widget);
+}
+
+void QWinUITheme::unregisterVisibleWidget(QWinUIWidget* widget)
+{
+    m_visibleWidgets.remove(widget);
+}
+
+quint64 QWinUITheme::themeChangeSerial() const
+{
+    return m_themeChangeSerial;
+}
+
+void QWinUITheme::beginUpdate()
+{
+    ++m_updateDepth;
+}
+
+void QWinUITheme::endUpdate()
+{
+    if (m_updateDepth <= 0) {
+        qWarning() << "QWinUITheme::endUpdate called without matching beginUpdate";
+        return;
+    }
+
+    if (--m_updateDepth > 0) {
+        return;
+    }
+
+    if (m_hasStagedColors) {
+        publishPalette(m_stagedColors);
+        m_hasStagedColors = false;
+    }
+
+    // 先清空待发状态，信号处理中再次修改主题时会开始新的一轮
+    const ColorTokenSet changedTokens = m_pendingTokens;
+    const ColorTokenSet colorSignals = m_pendingColorSignals;
+    const QStringList customColors = m_pendingCustomColors;
+    m_pendingTokens.reset();
+    m_pendingColorSignals.reset();
+    m_pendingCustomColors.clear();
+
+    for (int i = 0; i < ColorTokenCount; ++i) {
+        if (colorSignals.test(i)) {
+            const ColorToken token = static_cast<ColorToken>(i);
+            emit colorChanged(colorTokenName(token), getColor(token));
+        }
+    }
+    for (const QString& colorName : customColors) {
+        emit colorChanged(colorName, m_customColors.value(colorName));
+    }
+
+    if (changedTokens.any()) {
+        notifyThemeChanged(changedTokens);
+    }
+}
+
+bool QWinUITheme::isUpdating() const
+{
+    return m_updateDepth > 0;
+}
+
+void QWinUITheme::publishPalette(const ColorTable& colors)
+{
+    const quint64 generation = m_paletteGeneration.load(std::memory_order_relaxed) + 1;
+    PalettePtr palette = std::make_shared<const Palette>(colors, generation, m_isDarkMode, m_isHighContrast);
+    std::atomic_store(&m_palette, std::move(palette));
+    m_paletteGeneration.store(generation, std::memory_order_release);
 }
 
 QWinUIThemeMode QWinUITheme::themeMode() const
@@ -253,18 +567,10 @@ void QWinUITheme::setThemeMode(QWinUIThemeMode mode)
             bool newDarkMode = (mode == QWinUIThemeMode::Dark);
             if (m_isDarkMode != newDarkMode) {
                 m_isDarkMode = newDarkMode;
-                if (m_isDarkMode) {
-                    loadDarkTheme();
-                } else {
-                    loadLightTheme();
-                }
-                updateAccentColorVariants();
 
-                // 如果没有启用动画，直接发送主题改变信号
-                if (!m_themeTransitionEnabled) {
-                    emit themeChanged();
-                }
-                // 如果启用了动画，themeChanged 信号会在动画完成后发送
+                // 立即发送主题改变信号：启用动画时新主题在覆盖层下方绘制，
+                // 由覆盖层把旧主题快照逐步揭开
+                rebuildPalette();
             }
         }
 
@@ -279,11 +585,19 @@ QColor QWinUITheme::accentColor() const
 
 void QWinUITheme::setAccentColor(const QColor& color)
 {
+    m_accentOverridden = true;
     if (m_accentColor != color) {
         m_accentColor = color;
-        updateAccentColorVariants();
+
         emit accentColorChanged(color);
-        emit themeChanged();
+
+        // 在当前颜色基础上替换强调色变体，保留其余颜色（包括 setColor 的修改）
+        if (!m_isHighContrast) {
+            ColorTable colors = currentColors();
+            applyAccentColorVariants(colors);
+
+            commitColors(colors, accentColorTokens());
+        }
     }
 }
 
@@ -398,14 +712,67 @@ bool QWinUITheme::isDarkMode() const
     return m_isDarkMode;
 }
 
+bool QWinUITheme::isHighContrast() const
+{
+    return m_isHighContrast;
+}
+
+void QWinUITheme::setHighContrast(bool enabled)
+{
+    if (m_isHighContrast != enabled) {
+        if (m_themeTransitionEnabled) {
+            startThemeTransitionForAllWidgets();
+        }
+
+        m_isHighContrast = enabled;
+        emit highContrastChanged(enabled);
+        rebuildPalette();
+    }
+}
+
+QColor QWinUITheme::getColor(ColorToken token) const
+{
+    // GUI 线程是唯一替换快照的线程，这里直接读取无需原子操作
+    const QColor color = m_palette->color(token);
+    if (!color.isValid()) {
+        // 如果当前主题未定义该颜色，返回白色而不是洋红色
+        return QColor(255, 255, 255);
+    }
+    return color;
+}
+
+void QWinUITheme::setColor(ColorToken token, const QColor& color)
+{
+    const int index = static_cast<int>(token);
+    if (currentColors()[index] != color) {
+        // 快照不可修改，复制后替换单个颜色再提交
+        ColorTable colors = currentColors();
+        colors[index] = color;
+
+        ColorTokenSet changedTokens;
+        changedTokens.set(index);
+        m_overriddenTokens.set(index);
+
+        if (m_updateDepth > 0) {
+            m_pendingColorSignals.set(index);
+            commitColors(colors, changedTokens);
+            return;
+        }
+
+        publishPalette(colors);
+        emit colorChanged(colorTokenName(token), color);
+        notifyThemeChanged(changedTokens);
+    }
+}
+
 QColor QWinUITheme::getColor(const QString& colorName) const
 {
-    // 如果颜色映射为空，先加载默认主题
-    if (m_colors.isEmpty()) {
-        const_cast<QWinUITheme*>(this)->loadLightTheme();
+    ColorToken token;
+    if (colorTokenFromName(colorName, &token)) {
+        return getColor(token);
     }
 
-    QColor color = m_colors.value(colorName);
+    QColor color = m_customColors.value(colorName);
     if (!color.isValid()) {
         // 如果找不到颜色，返回白色而不是洋红色
         return QColor(255, 255, 255);
@@ -415,13 +782,80 @@ QColor QWinUITheme::getColor(const QString& colorName) const
 
 void QWinUITheme::setColor(const QString& colorName, const QColor& color)
 {
-    if (m_colors.value(colorName) != color) {
-        m_colors[colorName] = color;
+    ColorToken token;
+    if (colorTokenFromName(colorName, &token)) {
+        setColor(token, color);
+        return;
+    }
+
+    if (m_customColors.value(colorName) != color) {
+        m_customColors[colorName] = color;
+
+        // 自定义颜色无法对应到令牌，按全部变化处理
+        if (m_updateDepth > 0) {
+            if (!m_pendingCustomColors.contains(colorName)) {
+                m_pendingCustomColors.append(colorName);
+            }
+            m_pendingTokens.set();
+            return;
+        }
+
         emit colorChanged(colorName, color);
-        emit themeChanged();
+        notifyThemeChanged(ColorTokenSet().set());
     }
 }
 
+QWinUITheme::ColorTokenSet QWinUITheme::colorTokenSet(std::initializer_list<ColorToken> tokens)
+{
+    ColorTokenSet set;
+    for (ColorToken token : tokens) {
+        set.set(static_cast<int>(token));
+    }
+    return set;
+}
+
+QWinUITheme::ColorTokenSet QWinUITheme::accentColorTokens()
+{
+    return colorTokenSet({ ColorToken::SystemAccentColor,
+                           ColorToken::SystemAccentColorLight1,
+                           ColorToken::SystemAccentColorLight2,
+                           ColorToken::SystemAccentColorLight3,
+                           ColorToken::SystemAccentColorDark1,
+                           ColorToken::SystemAccentColorDark2,
+                           ColorToken::SystemAccentColorDark3 });
+}
+
+QString QWinUITheme::colorTokenName(ColorToken token)
+{
+    const int index = static_cast<int>(token);
+    if (index < 0 || index >= ColorTokenCount) {
+        return QString();
+    }
+    return QString::fromLatin1(s_colorTokenNames[index]);
+}
+
+bool QWinUITheme::colorTokenFromName(const QString& colorName, ColorToken* token)
+{
+    // 名称到令牌的映射只构建一次
+    static const QHash<QString, ColorToken> nameToToken = []() {
+        QHash<QString, ColorToken> map;
+        map.reserve(ColorTokenCount);
+        for (int i = 0; i < ColorTokenCount; ++i) {
+            map.insert(QString::fromLatin1(s_colorTokenNames[i]), static_cast<ColorToken>(i));
+        }
+        return map;
+    }();
+
+    auto it = nameToToken.constFind(colorName);
+    if (it == nameToToken.constEnd()) {
+        return false;
+    }
+    if (token) {
+        *token = it.value();
+    }
+    return true;
+}
+
 QFont QWinUITheme::getFont(const QString& fontName) const
 {
     return m_fonts.value(fontName, QFont());
@@ -464,15 +898,27 @@ QColor QWinUITheme::getSystemAccentColor() const
     return QColor(0, 120, 215);
 }
 
-void QWinUITheme::updateAccentColorVariants()
+bool QWinUITheme::getSystemHighContrast() const
 {
-    m_colors[Colors::SystemAccentColor] = m_accentColor;
-    m_colors[Colors::SystemAccentColorLight1] = generateAccentVariant(m_accentColor, 1.2);
-    m_colors[Colors::SystemAccentColorLight2] = generateAccentVariant(m_accentColor, 1.4);
-    m_colors[Colors::SystemAccentColorLight3] = generateAccentVariant(m_accentColor, 1.6);
-    m_colors[Colors::SystemAccentColorDark1] = generateAccentVariant(m_accentColor, 0.8);
-    m_colors[Colors::SystemAccentColorDark2] = generateAccentVariant(m_accentColor, 0.6);
-    m_colors[Colors::SystemAccentColorDark3] = generateAccentVariant(m_accentColor, 0.4);
+#ifdef Q_OS_WIN
+    HIGHCONTRASTW highContrast = {};
+    highContrast.cbSize = sizeof(highContrast);
+    if (SystemParametersInfoW(SPI_GETHIGHCONTRAST, sizeof(highContrast), &highContrast, 0)) {
+        return (highContrast.dwFlags & HCF_HIGHCONTRASTON) != 0;
+    }
+#endif
+    return false;
+}
+
+void QWinUITheme::applyAccentColorVariants(ColorTable& colors) const
+{
+    colors[static_cast<int>(ColorToken::SystemAccentColor)] = m_accentColor;
+    colors[static_cast<int>(ColorToken::SystemAccentColorLight1)] = generateAccentVariant(m_accentColor, 1.2);
+    colors[static_cast<int>(ColorToken::SystemAccentColorLight2)] = generateAccentVariant(m_accentColor, 1.4);
+    colors[static_cast<int>(ColorToken::SystemAccentColorLight3)] = generateAccentVariant(m_accentColor, 1.6);
+    colors[static_cast<int>(ColorToken::SystemAccentColorDark1)] = generateAccentVariant(m_accentColor, 0.8);
+    colors[static_cast<int>(ColorToken::SystemAccentColorDark2)] = generateAccentVariant(m_accentColor, 0.6);
+    colors[static_cast<int>(ColorToken::SystemAccentColorDark3)] = generateAccentVariant(m_accentColor, 0.4);
 }
 
 QColor QWinUITheme::generateAccentVariant(const QColor& baseColor, double factor) const
@@ -511,33 +957,166 @@ void QWinUITheme::onSystemThemeChanged()
 
     if (m_isDarkMode != newDarkMode) {
         m_isDarkMode = newDarkMode;
+        rebuildPalette();
+    }
+}
 
-        if (m_isDarkMode) {
-            loadDarkTheme();
-        } else {
-            loadLightTheme();
+QString QWinUITheme::defaultThemeFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation) + "/qwinui_theme.qwt";
+}
+
+bool QWinUITheme::saveTheme(const QString& filePath) const
+{
+    const QString path = filePath.isEmpty() ? defaultThemeFilePath() : filePath;
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    // 先序列化到内存，再一次性写入，写入失败时不会破坏原文件
+    QByteArray data;
+    {
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_6_0);
+
+        out << THEME_FILE_MAGIC << THEME_FILE_VERSION;
+        out << static_cast<qint32>(m_themeMode) << m_isHighContrast;
+
+        // 只保存用户指定的强调色和颜色；其余颜色由主题模式和强调色推导，
+        // 加载时重新生成，之后调色板或系统强调色的变化仍然生效
+        out << m_accentOverridden << (m_accentOverridden ? m_accentColor : QColor());
+
+        // 颜色按令牌名称保存，枚举顺序调整后旧文件仍可读取
+        const ColorTable& colors = currentColors();
+        QList<int> overriddenTokens;
+        for (int i = 0; i < ColorTokenCount; ++i) {
+            if (m_overriddenTokens.test(i) && colors[i].isValid()) {
+                overriddenTokens.append(i);
+            }
+        }
+        out << static_cast<quint32>(overriddenTokens.size());
+        for (int index : overriddenTokens) {
+            out << QString::fromLatin1(s_colorTokenNames[index]) << colors[index];
         }
 
-        updateAccentColorVariants();
-        emit themeChanged();
+        out << m_customColors << m_fonts << m_spacing;
     }
-}
 
-void QWinUITheme::saveTheme(const QString& filePath) const
-{
-    // 实现主题保存功能
-    Q_UNUSED(filePath)
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Cannot open theme file for writing:" << path;
+        return false;
+    }
+    file.write(data);
+    if (!file.commit()) {
+        qWarning() << "Failed to write theme file:" << path;
+        return false;
+    }
+    return true;
 }
 
-void QWinUITheme::loadTheme(const QString& filePath)
+bool QWinUITheme::loadTheme(const QString& filePath)
 {
-    // 实现主题加载功能
-    Q_UNUSED(filePath)
+    const QString path = filePath.isEmpty() ? defaultThemeFilePath() : filePath;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Cannot open theme file:" << path;
+        return false;
+    }
+
+    // 优先映射整个文件，避免逐段读取；不支持映射时退回一次性读取
+    QByteArray data;
+    if (uchar* mapped = file.map(0, file.size())) {
+        data = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), static_cast<qsizetype>(file.size()));
+    } else {
+        data = file.readAll();
+    }
+
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != THEME_FILE_MAGIC || version != THEME_FILE_VERSION) {
+        qWarning() << "Invalid or unsupported theme file:" << path;
+        return false;
+    }
+
+    qint32 themeMode = 0;
+    QColor accentColor;
+    bool accentOverridden = false;
+    bool highContrast = false;
+    in >> themeMode >> highContrast >> accentOverridden >> accentColor;
+
+    quint32 colorCount = 0;
+    in >> colorCount;
+    QList<QPair<ColorToken, QColor>> colors;
+    colors.reserve(static_cast<qsizetype>(qMin<quint32>(colorCount, ColorTokenCount)));
+    for (quint32 i = 0; i < colorCount && in.status() == QDataStream::Ok; ++i) {
+        QString colorName;
+        QColor color;
+        in >> colorName >> color;
+
+        // 当前版本不认识的令牌直接忽略
+        ColorToken token;
+        if (colorTokenFromName(colorName, &token)) {
+            colors.append(qMakePair(token, color));
+        }
+    }
+
+    QMap<QString, QColor> customColors;
+    QMap<QString, QFont> fonts;
+    QMap<QString, int> spacing;
+    in >> customColors >> fonts >> spacing;
+
+    // 完整解析成功后才修改主题，避免损坏的文件留下半套配置
+    if (in.status() != QDataStream::Ok
+        || themeMode < static_cast<qint32>(QWinUIThemeMode::Light)
+        || themeMode > static_cast<qint32>(QWinUIThemeMode::Auto)
+        || (accentOverridden && !accentColor.isValid())) {
+        qWarning() << "Corrupted theme file:" << path;
+        return false;
+    }
+
+    // 所有修改合并为一次 themeChanged；加载属于启动配置，不播放主题切换动画
+    const bool transitionEnabled = m_themeTransitionEnabled;
+    m_themeTransitionEnabled = false;
+    beginUpdate();
+
+    setHighContrast(highContrast);
+    setThemeMode(static_cast<QWinUIThemeMode>(themeMode));
+    if (accentOverridden) {
+        setAccentColor(accentColor);
+    } else {
+        setAccentColor(getSystemAccentColor());
+        m_accentOverridden = false;
+    }
+
+    // 从基础调色板开始应用文件中的修改，丢弃加载前的 setColor 修改
+    rebuildPalette();
+
+    for (const auto& entry : std::as_const(colors)) {
+        setColor(entry.first, entry.second);
+    }
+    for (auto it = customColors.constBegin(); it != customColors.constEnd(); ++it) {
+        setColor(it.key(), it.value());
+    }
+    for (auto it = fonts.constBegin(); it != fonts.constEnd(); ++it) {
+        m_fonts[it.key()] = it.value();
+    }
+    for (auto it = spacing.constBegin(); it != spacing.constEnd(); ++it) {
+        m_spacing[it.key()] = it.value();
+    }
+
+    endUpdate();
+    m_themeTransitionEnabled = transitionEnabled;
+    return true;
 }
 
 void QWinUITheme::resetToDefault()
 {
     m_accentColor = getSystemAccentColor();
+    m_accentOverridden = false;
     setThemeMode(QWinUIThemeMode::Auto);
     setFollowSystemTheme(true);
 }
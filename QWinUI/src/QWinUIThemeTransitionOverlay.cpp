@@ -0,0 +1,230 @@
+#include "QWinUIThemeTransitionOverlay.h"
+#include "QWinUI/QWinUIFrameClock.h"
+#include <QEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QPaintEvent>
+#include <QTimer>
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+QWinUIThemeTransitionOverlay::QWinUIThemeTransitionOverlay(QWidget* window)
+    : QWidget(window)
+    , m_window(window)
+    , m_mode(QWinUIWidget::RippleTransition)
+    , m_capturing(false)
+    , m_running(false)
+    , m_maxRadius(0.0)
+    , m_progress(0.0)
+{
+    // 覆盖层不接收鼠标事件，且每帧完整绘制自身区域
+    setAttribute(Qt::WA_TransparentForMouseEvents, true);
+    setAttribute(Qt::WA_OpaquePaintEvent, true);
+    setAttribute(Qt::WA_NoSystemBackground, true);
+    setFocusPolicy(Qt::NoFocus);
+    hide();
+
+    m_window->installEventFilter(this);
+}
+
+QWinUIThemeTransitionOverlay::~QWinUIThemeTransitionOverlay()
+{
+    QWinUIFrameClock::getInstance()->unsubscribe(this);
+
+    if (m_window) {
+        m_window->removeEventFilter(this);
+    }
+    if (m_windowHandle) {
+        m_windowHandle->removeEventFilter(this);
+    }
+}
+
+QWinUIThemeTransitionOverlay* QWinUIThemeTransitionOverlay::find(const QWidget* window)
+{
+    if (!window) {
+        return nullptr;
+    }
+
+    const auto overlays = window->findChildren<QWinUIThemeTransitionOverlay*>(QString(), Qt::FindDirectChildrenOnly);
+    for (QWinUIThemeTransitionOverlay* overlay : overlays) {
+        if (overlay->isRunning()) {
+            return overlay;
+        }
+    }
+    return nullptr;
+}
+
+void QWinUIThemeTransitionOverlay::start(QWinUIWidget::QWinUITransitionMode mode, const QPoint& center)
+{
+    m_mode = mode;
+    m_center = center;
+    m_progress = 0.0;
+
+    // 旧主题快照：此时覆盖层尚未显示，主题也还没有切换
+    m_oldSnapshot = m_window->grab();
+    m_newSnapshot = QPixmap();
+
+    // 涟漪最大半径为中心到窗口最远角的距离
+    const QRect windowRect = m_window->rect();
+    const QPoint corners[4] = {
+        windowRect.topLeft(),
+        windowRect.topRight(),
+        windowRect.bottomLeft(),
+        windowRect.bottomRight()
+    };
+    m_maxRadius = 0.0;
+    for (const QPoint& corner : corners) {
+        m_maxRadius = std::max(m_maxRadius, std::hypot(double(corner.x() - m_center.x()),
+                                                       double(corner.y() - m_center.y())));
+    }
+
+    setGeometry(windowRect);
+    raise();
+    show();
+
+    m_running = true;
+    m_elapsed.start();
+    QWinUIFrameClock::getInstance()->subscribe(this, [this](qint64) { onTick(); });
+
+    // 窗口不再暴露时帧时钟暂停，旧快照会一直盖住窗口，直接结束
+    m_windowHandle = m_window->windowHandle();
+    if (m_windowHandle) {
+        m_windowHandle->installEventFilter(this);
+    }
+
+    // 帧回调因任何原因停止时，按墙钟时间兜底结束，不会阻塞之后的主题切换
+    const int duration = (m_mode == QWinUIWidget::FadeTransition) ? FADE_DURATION_MS : RIPPLE_DURATION_MS;
+    QTimer::singleShot(duration + TIMEOUT_MARGIN_MS, this, [this]() { finish(); });
+}
+
+bool QWinUIThemeTransitionOverlay::isRunning() const
+{
+    return m_running;
+}
+
+void QWinUIThemeTransitionOverlay::captureNewSnapshot()
+{
+    // 抓取期间覆盖层不绘制任何内容，得到的即是下层新主题的画面。
+    // 不透明的子控件会把它下方的区域从绘制范围中扣除，抓取期间临时取消不透明属性，
+    // 窗口和覆盖层下方的兄弟控件才会被绘制
+    m_capturing = true;
+    setAttribute(Qt::WA_OpaquePaintEvent, false);
+    m_newSnapshot = m_window->grab();
+    setAttribute(Qt::WA_OpaquePaintEvent, true);
+    m_capturing = false;
+}
+
+void QWinUIThemeTransitionOverlay::onTick()
+{
+    if (!m_running) {
+        return;
+    }
+
+    // 第一帧时主题已经切换完毕，抓取一次新主题快照
+    if (m_newSnapshot.isNull()) {
+        captureNewSnapshot();
+        update();
+    }
+
+    const int duration = (m_mode == QWinUIWidget::FadeTransition) ? FADE_DURATION_MS : RIPPLE_DURATION_MS;
+    const double previousRadius = m_maxRadius * m_progress;
+    m_progress = qMin(1.0, m_elapsed.elapsed() / double(duration));
+
+    if (m_mode == QWinUIWidget::RippleTransition) {
+        // 只重绘本帧圆圈覆盖到的区域
+        update(rippleBounds(m_maxRadius * m_progress).united(rippleBounds(previousRadius)));
+    } else {
+        update();
+    }
+
+    if (m_progress >= 1.0) {
+        finish();
+    }
+}
+
+QRect QWinUIThemeTransitionOverlay::rippleBounds(double radius) const
+{
+    const int r = static_cast<int>(std::ceil(radius)) + 1;
+    return QRect(m_center.x() - r, m_center.y() - r, r * 2, r * 2).intersected(rect());
+}
+
+void QWinUIThemeTransitionOverlay::finish()
+{
+    if (!m_running) {
+        return;
+    }
+
+    m_running = false;
+    QWinUIFrameClock::getInstance()->unsubscribe(this);
+    if (m_windowHandle) {
+        m_windowHandle->removeEventFilter(this);
+    }
+    m_oldSnapshot = QPixmap();
+    m_newSnapshot = QPixmap();
+    hide();
+
+    emit finished();
+    deleteLater();
+}
+
+void QWinUIThemeTransitionOverlay::paintEvent(QPaintEvent* event)
+{
+    if (m_capturing || m_oldSnapshot.isNull()) {
+        return;
+    }
+
+    QPainter painter(this);
+    painter.setClipRegion(event->region());
+    // 快照本身已包含透明度信息，直接替换像素
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+
+    if (m_newSnapshot.isNull()) {
+        painter.drawPixmap(0, 0, m_oldSnapshot);
+        return;
+    }
+
+    if (m_mode == QWinUIWidget::FadeTransition) {
+        painter.drawPixmap(0, 0, m_newSnapshot);
+        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        painter.setOpacity(1.0 - m_progress);
+        painter.drawPixmap(0, 0, m_oldSnapshot);
+        return;
+    }
+
+    // 圆圈扩散：圆外为旧主题，圆内为新主题
+    const double radius = m_maxRadius * m_progress;
+    painter.drawPixmap(0, 0, m_oldSnapshot);
+
+    if (radius > 0.0) {
+        QPainterPath circle;
+        circle.addEllipse(QPointF(m_center), radius, radius);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setClipPath(circle, Qt::IntersectClip);
+        painter.drawPixmap(0, 0, m_newSnapshot);
+    }
+}
+
+bool QWinUIThemeTransitionOverlay::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched == m_windowHandle && m_running) {
+        if (event->type() == QEvent::Expose && !m_windowHandle->isExposed()) {
+            finish();
+        }
+        return QWidget::eventFilter(watched, event);
+    }
+
+    if (watched == m_window && m_running) {
+        // 窗口尺寸变化、隐藏或最小化时快照失效，直接结束动画
+        if (event->type() == QEvent::Resize || event->type() == QEvent::Hide
+            || (event->type() == QEvent::WindowStateChange && m_window->isMinimized())) {
+            finish();
+        } else if (event->type() == QEvent::ChildAdded) {
+            // 保持覆盖层位于最上层
+            QMetaObject::invokeMethod(this, [this]() { raise(); }, Qt::QueuedConnection);
+        }
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,70 @@
+#ifndef QWINUITHEMETRANSITIONOVERLAY_H
+#define QWINUITHEMETRANSITIONOVERLAY_H
+
+#include "QWinUI/QWinUIWidget.h"
+#include <QWidget>
+#include <QPixmap>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QWindow>
+
+QT_BEGIN_NAMESPACE
+
+// 主题切换动画覆盖层（内部类）
+// 切换前把整个窗口抓取为旧主题快照，新主题在下层正常绘制后再抓取一次，
+// 动画期间只由这一个覆盖层按经过的时间合成两张快照，
+// 每帧开销与窗口中的控件数量无关
+class QWinUIThemeTransitionOverlay : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit QWinUIThemeTransitionOverlay(QWidget* window);
+    ~QWinUIThemeTransitionOverlay();
+
+    // 查找窗口上正在运行的覆盖层
+    static QWinUIThemeTransitionOverlay* find(const QWidget* window);
+
+    // center 为窗口坐标系下的涟漪中心
+    void start(QWinUIWidget::QWinUITransitionMode mode, const QPoint& center);
+
+    bool isRunning() const;
+
+signals:
+    void finished();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    void onTick();
+    void captureNewSnapshot();
+    void finish();
+    QRect rippleBounds(double radius) const;
+
+private:
+    QWidget* m_window;
+    QPointer<QWindow> m_windowHandle; // 监听暴露状态
+    QWinUIWidget::QWinUITransitionMode m_mode;
+
+    QPixmap m_oldSnapshot;
+    QPixmap m_newSnapshot;
+    bool m_capturing;
+    bool m_running;
+
+    QPoint m_center;
+    double m_maxRadius;
+    double m_progress; // 0.0 到 1.0，由经过的时间计算
+
+    // 由共享帧时钟驱动，进度按经过的时间计算
+    QElapsedTimer m_elapsed;
+
+    static constexpr int RIPPLE_DURATION_MS = 650;
+    static constexpr int FADE_DURATION_MS = 500;
+    static constexpr int TIMEOUT_MARGIN_MS = 500; // 超过动画时长这么久仍未结束时强制结束
+};
+
+QT_END_NAMESPACE
+
+#endif // QWINUITHEMETRANSITIONOVERLAY_H